@@ -0,0 +1,48 @@
+// N = 10000 tables built in constant evaluation: value construction, fill, copy and the relocating
+// insert and erase all run through the constexpr fallbacks of detail::ipv::memory, for trivial
+// elements (typed_storage) and non-trivial ones (byte_storage).
+#include <cstddef>
+
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+constexpr auto size = std::size_t{ 10000 };
+
+struct entry
+{
+  int key{ -1 };
+
+  constexpr entry(int k) : key{ k } {}
+  entry() = default;
+  constexpr ~entry() {}
+};
+
+template <typename T>
+constexpr auto
+make_table() -> mtp::inplace_vector<T, size>
+{
+  auto table = mtp::inplace_vector<T, size>{};
+  table.resize(size / 2);
+  table.assign(size / 2, T{ 1 });
+  auto const copy = table;
+  table.insert(table.begin(), copy.begin(), copy.end());
+  table.erase(table.begin(), table.begin() + size / 4);
+  for (auto i = std::size_t{ 0 }; i < table.size(); ++i) {
+    table[i] = T{ static_cast<int>(i) };
+  }
+  return table;
+}
+
+constexpr auto ints = make_table<int>();
+constexpr auto entries = make_table<entry>();
+static_assert(ints.size() == size * 3 / 4 && ints.back() == size * 3 / 4 - 1);
+static_assert(entries.size() == size * 3 / 4 && entries.back().key == size * 3 / 4 - 1);
+
+} // namespace
+
+auto
+lookup(std::size_t i) -> int
+{
+  return ints[i] + entries[i].key;
+}
@@ -0,0 +1,2 @@
+// baseline: parsing the header, nothing instantiated
+#include <mtp/inplace_vector.hpp>
@@ -0,0 +1,37 @@
+// Every specialization of MTP_INPLACE_VECTOR_INSTANTIATIONS, each through the members a typical
+// user touches. MTP_COMPILE_BENCH_EXTERN adds the explicit instantiation declarations that the
+// module build with MTP_EXPLICIT_INSTANTIATIONS makes reachable: the difference is what a
+// translation unit no longer compiles.
+#include <cstddef>
+
+#include <mtp/inplace_vector.hpp>
+#include <mtp/inplace_vector_instantiations.hpp>
+
+#ifdef MTP_COMPILE_BENCH_EXTERN
+#  define MTP_EXTERN_TEMPLATE(T, N) extern template class mtp::inplace_vector<T, N>;
+MTP_INPLACE_VECTOR_INSTANTIATIONS(MTP_EXTERN_TEMPLATE)
+#endif
+
+template <typename T, std::size_t N>
+auto
+use(T const& value) -> std::size_t
+{
+  auto ipv = mtp::inplace_vector<T, N>(N / 2, value);
+  ipv.push_back(value);
+  ipv.insert(ipv.begin(), value);
+  ipv.erase(ipv.begin() + 1);
+  auto copy = ipv;
+  copy.resize(N);
+  ipv.assign(copy.begin(), copy.end() - 1);
+  return ipv.size() + (ipv == copy ? 1 : 0);
+}
+
+auto
+use_all() -> std::size_t
+{
+  auto total = std::size_t{ 0 };
+#define MTP_USE(T, N) total += use<T, N>(T{});
+  MTP_INPLACE_VECTOR_INSTANTIATIONS(MTP_USE)
+#undef MTP_USE
+  return total;
+}
@@ -0,0 +1,63 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// Compiles a source of bench/compile to an object file with this build's compiler and flags; each
+// benchmark sample is one compiler run.
+auto
+compile(std::string const& source, std::string const& options = "") -> int
+{
+  auto const command = std::string("\"") + MTP_COMPILE_COMPILER + "\" " + MTP_COMPILE_FLAGS +
+                       " -I\"" + MTP_COMPILE_INCLUDE_DIR + "\" " + options + " -c \"" +
+                       MTP_COMPILE_SOURCE_DIR + "/" + source + "\" -o \"" +
+                       MTP_COMPILE_BINARY_DIR + "/" + source + ".o\"";
+  return std::system(command.c_str());
+}
+
+} // namespace
+
+TEST_CASE("compile time", "[benchmark][compile]")
+{
+  // fails fast on a broken command instead of timing it
+  REQUIRE(compile("header_only.cpp") == 0);
+
+  BENCHMARK("parse inplace_vector.hpp")
+  {
+    return compile("header_only.cpp");
+  };
+
+  BENCHMARK("instantiate 32 inplace_vector<T, N>")
+  {
+    return compile("instantiations.cpp");
+  };
+
+  // header-only members are inline, so optimizing builds may still instantiate them for inlining;
+  // the module's are not, see MTP_EXPLICIT_INSTANTIATIONS
+  BENCHMARK("instantiate 32 inplace_vector<T, N> declared extern")
+  {
+    return compile("instantiations.cpp", "-DMTP_COMPILE_BENCH_EXTERN");
+  };
+
+  BENCHMARK("constexpr tables of 10000 elements")
+  {
+    return compile("constexpr_table.cpp");
+  };
+}
+
+auto
+main(int argc, char* argv[]) -> int
+{
+  auto session = Catch::Session();
+  // compiler runs take seconds, not nanoseconds
+  session.configData().benchmarkSamples = 5;
+  session.configData().benchmarkResamples = 1000;
+  session.configData().benchmarkWarmupTime = 0;
+  if (auto const error = session.applyCommandLine(argc, argv); error != 0) {
+    return error;
+  }
+  return session.run();
+}
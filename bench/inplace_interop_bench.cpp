@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mtp/inplace_vector.hpp>
+#include <mtp/inplace_vector_interop.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+// a move-only handle: its move constructor nulls the source, so moving is per-element work, but
+// the bits can be relocated
+struct handle
+{
+  int* p{ nullptr };
+
+  handle() = default;
+  explicit handle(int* ptr) noexcept : p(ptr) {}
+  handle(handle&& other) noexcept : p(std::exchange(other.p, nullptr)) {}
+  auto operator=(handle&& other) noexcept -> handle&
+  {
+    p = std::exchange(other.p, nullptr);
+    return *this;
+  }
+};
+
+} // namespace
+
+template <>
+struct mtp::is_trivially_relocatable<handle> : std::true_type
+{};
+
+namespace {
+
+template <typename T>
+auto
+make_value(std::size_t i) -> T
+{
+  if constexpr (std::is_same_v<T, handle>) {
+    return handle(reinterpret_cast<int*>(i * alignof(int)));
+  }
+  else if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(24, static_cast<char>('a' + i % 26));
+  }
+  else {
+    return static_cast<T>(i);
+  }
+}
+
+// Each benchmark moves N elements from a std::vector into an inplace_vector and back, reusing
+// the vector's allocation; only the direction being measured differs between the pairs.
+template <typename T, std::size_t N>
+auto
+bench_interop(std::string const& type) -> void
+{
+  using IpvT = inplace_vector<T, N>;
+  auto const suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+  auto vec = std::vector<T>{};
+  for (auto i = std::size_t{ 0 }; i < N; ++i) {
+    vec.push_back(make_value<T>(i));
+  }
+  auto const move_back = [&vec](IpvT& ipv) {
+    vec.assign(std::make_move_iterator(ipv.begin()), std::make_move_iterator(ipv.end()));
+    ipv.clear();
+  };
+
+  BENCHMARK("iterator pair from std::vector" + suffix)
+  {
+    auto ipv = IpvT(std::make_move_iterator(vec.begin()), std::make_move_iterator(vec.end()));
+    vec.clear();
+    move_back(ipv);
+    return vec.size();
+  };
+
+  BENCHMARK("from_vector" + suffix)
+  {
+    auto ipv = mtp::from_vector<N>(std::move(vec));
+    move_back(ipv);
+    return vec.size();
+  };
+
+  // these allocate a new vector each time, on both sides
+  BENCHMARK("iterator pair into std::vector" + suffix)
+  {
+    auto ipv = mtp::from_vector<N>(std::move(vec));
+    vec = std::vector<T>(std::make_move_iterator(ipv.begin()), std::make_move_iterator(ipv.end()));
+    return vec.size();
+  };
+
+  BENCHMARK("into_vector" + suffix)
+  {
+    vec = mtp::into_vector(mtp::from_vector<N>(std::move(vec)));
+    return vec.size();
+  };
+}
+
+} // namespace
+
+TEST_CASE("std::vector interop", "[benchmark][inplace_vector]")
+{
+  bench_interop<int, 64>("int");
+  bench_interop<int, 1024>("int");
+  bench_interop<handle, 64>("handle");
+  bench_interop<handle, 1024>("handle");
+  bench_interop<std::string, 64>("string");
+}
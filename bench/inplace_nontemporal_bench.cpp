@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <mtp/inplace_nontemporal.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using buffer = mtp::inplace_vector<std::byte, 65536>;
+
+// The producer fills 64 KiB buffers that are handed to another core, round robin over more
+// buffers than the last level cache holds, and in between works on a table that fits in L2. A
+// cached copy brings every destination line into the producer's cache (evicting the table); a
+// streaming copy does not, so the time of the table pass is a proxy for the producer's cache misses.
+// Run under `perf stat -e cache-misses` for the counts themselves.
+constexpr auto buffer_count = std::size_t{ 256 }; // 16 MiB of destinations
+constexpr auto table_size = std::size_t{ 192 * 1024 / sizeof(std::uint64_t) };
+
+auto
+make_payload() -> std::vector<std::byte>
+{
+  auto payload = std::vector<std::byte>(65536);
+  for (auto i = std::size_t{ 0 }; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i * 31 + 7);
+  }
+  return payload;
+}
+
+auto
+sum(std::vector<std::uint64_t> const& table) -> std::uint64_t
+{
+  return std::accumulate(table.begin(), table.end(), std::uint64_t{ 0 });
+}
+
+} // namespace
+
+TEST_CASE("nontemporal copies", "[benchmark][inplace_vector]")
+{
+  auto const payload = make_payload();
+  auto buffers = std::vector<buffer>(buffer_count);
+  auto table = std::vector<std::uint64_t>(table_size);
+  std::iota(table.begin(), table.end(), std::uint64_t{ 0 });
+  auto next = std::size_t{ 0 };
+
+  BENCHMARK("assign_range 64 KiB")
+  {
+    auto& dst = buffers[next++ % buffer_count];
+    dst.assign_range(payload);
+    return dst.size();
+  };
+
+  BENCHMARK("assign_range(nontemporal) 64 KiB")
+  {
+    auto& dst = buffers[next++ % buffer_count];
+    mtp::assign_range(mtp::nontemporal, dst, payload);
+    return dst.size();
+  };
+
+  BENCHMARK("table pass alone")
+  {
+    return sum(table);
+  };
+
+  BENCHMARK("assign_range 64 KiB + table pass")
+  {
+    auto& dst = buffers[next++ % buffer_count];
+    dst.assign_range(payload);
+    return sum(table) + dst.size();
+  };
+
+  BENCHMARK("assign_range(nontemporal) 64 KiB + table pass")
+  {
+    auto& dst = buffers[next++ % buffer_count];
+    mtp::assign_range(mtp::nontemporal, dst, payload);
+    return sum(table) + dst.size();
+  };
+}
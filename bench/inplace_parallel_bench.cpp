@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mtp/inplace_parallel.hpp>
+
+namespace {
+
+using batch = mtp::inplace_vector<std::uint32_t, 32>;
+
+auto
+make_batches(std::size_t count) -> std::vector<batch>
+{
+  auto batches = std::vector<batch>(count);
+  auto seed = std::uint32_t{ 12345 };
+  for (auto& ipv : batches) {
+    seed = seed * 1103515245u + 12345u;
+    auto const size = (seed >> 16) % 33;
+    for (auto i = 0u; i < size; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      ipv.unchecked_push_back(seed >> 8);
+    }
+  }
+  return batches;
+}
+
+} // namespace
+
+TEST_CASE("batch algorithms", "[benchmark][inplace_parallel]")
+{
+  constexpr auto count = std::size_t{ 1 } << 16;
+  auto const nproc = std::max(1u, std::thread::hardware_concurrency());
+  auto const original = make_batches(count);
+
+  // both sides sort a fresh copy, so the copy is part of every measurement
+  BENCHMARK("serial sort of 2^16 inplace_vector<uint32_t, 32>")
+  {
+    auto batches = original;
+    for (auto& ipv : batches) {
+      mtp::sort(ipv);
+    }
+    return batches.size();
+  };
+
+  // 1, 2, 4, ... up to and including nproc
+  for (auto threads = 1u;; threads = std::min(threads * 2, nproc)) {
+    auto pool = mtp::batch_pool(threads);
+    BENCHMARK("sort_each of 2^16 inplace_vector<uint32_t, 32> on " + std::to_string(threads) +
+              " threads")
+    {
+      auto batches = original;
+      return mtp::sort_each(pool, batches).chunks;
+    };
+    if (threads == nproc) {
+      break;
+    }
+  }
+}
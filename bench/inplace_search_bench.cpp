@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mtp/inplace_algorithm.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+template <typename T, std::size_t N>
+auto
+bench_search(std::string const& type) -> void
+{
+  auto const suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+  // vectors of random fill level, queries hit about half of the time
+  auto rng = std::mt19937_64{ 11 };
+  auto inputs = std::vector<inplace_vector<T, N>>(1024);
+  for (auto& ipv : inputs) {
+    auto const size = rng() % (N + 1);
+    for (auto i = 0u; i < size; ++i) {
+      ipv.push_back(static_cast<T>(rng() % (2 * N)));
+    }
+  }
+  auto queries = std::vector<T>(inputs.size());
+  for (auto& q : queries) {
+    q = static_cast<T>(rng() % (2 * N));
+  }
+
+  BENCHMARK("std::find" + suffix)
+  {
+    auto hits = std::size_t{ 0 };
+    for (auto i = 0u; i < inputs.size(); ++i) {
+      hits += std::find(inputs[i].begin(), inputs[i].end(), queries[i]) != inputs[i].end();
+    }
+    return hits;
+  };
+
+  BENCHMARK("mtp::contains" + suffix)
+  {
+    auto hits = std::size_t{ 0 };
+    for (auto i = 0u; i < inputs.size(); ++i) {
+      hits += mtp::contains(inputs[i], queries[i]);
+    }
+    return hits;
+  };
+
+  BENCHMARK("std::count" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i < inputs.size(); ++i) {
+      total += static_cast<std::size_t>(std::count(inputs[i].begin(), inputs[i].end(), queries[i]));
+    }
+    return total;
+  };
+
+  BENCHMARK("mtp::count" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i < inputs.size(); ++i) {
+      total += mtp::count(inputs[i], queries[i]);
+    }
+    return total;
+  };
+}
+
+} // namespace
+
+TEST_CASE("search", "[benchmark][inplace_algorithm]")
+{
+  bench_search<std::uint32_t, 16>("uint32_t");
+  bench_search<std::uint32_t, 64>("uint32_t");
+  bench_search<std::uint32_t, 256>("uint32_t");
+  bench_search<std::uint8_t, 64>("uint8_t");
+  bench_search<std::uint64_t, 64>("uint64_t");
+  bench_search<float, 64>("float");
+}
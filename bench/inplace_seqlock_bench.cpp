@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mtp/seqlock_inplace_vector.hpp>
+
+namespace {
+
+using table = mtp::inplace_vector<std::uint64_t, 256>;
+
+// `readers` threads take `reads` snapshots each while one writer republishes the table as fast as
+// it can; returns a checksum of what the readers saw
+template <typename Publish, typename Read>
+auto
+read_mostly(unsigned readers, std::uint64_t reads, Publish publish, Read read) -> std::uint64_t
+{
+  auto remaining = std::atomic<unsigned>{ readers };
+  auto sum = std::atomic<std::uint64_t>{ 0 };
+  auto threads = std::vector<std::thread>{};
+  for (auto r = 0u; r < readers; ++r) {
+    threads.emplace_back([&] {
+      auto local = std::uint64_t{ 0 };
+      for (auto i = std::uint64_t{ 0 }; i < reads; ++i) {
+        local += read().back();
+      }
+      sum.fetch_add(local, std::memory_order_relaxed);
+      remaining.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  auto next = table(256, 0);
+  while (remaining.load(std::memory_order_acquire) != 0) {
+    ++next.back();
+    publish(next);
+    std::this_thread::yield();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return sum.load();
+}
+
+} // namespace
+
+TEST_CASE("seqlock snapshots", "[benchmark][seqlock_inplace_vector]")
+{
+  constexpr auto reads = std::uint64_t{ 20'000 };
+  auto const nproc = std::max(1u, std::thread::hardware_concurrency());
+
+  for (auto readers = 1u;; readers = std::min(readers * 2, nproc)) {
+    auto const suffix = " x 20k, " + std::to_string(readers) + " readers";
+
+    BENCHMARK("shared_mutex copy of inplace_vector<uint64_t, 256>" + suffix)
+    {
+      auto mutex = std::shared_mutex{};
+      auto current = table(256, 0);
+      return read_mostly(
+          readers, reads,
+          [&](table const& next) {
+            auto const lock = std::unique_lock(mutex);
+            current = next;
+          },
+          [&] {
+            auto const lock = std::shared_lock(mutex);
+            return current;
+          });
+    };
+
+    BENCHMARK("seqlock_inplace_vector<uint64_t, 256> load" + suffix)
+    {
+      auto current = mtp::seqlock_inplace_vector<std::uint64_t, 256>(table(256, 0));
+      return read_mostly(
+          readers, reads, [&](table const& next) { current.publish(next); },
+          [&] { return current.load(); });
+    };
+
+    if (readers == nproc) {
+      break;
+    }
+  }
+}
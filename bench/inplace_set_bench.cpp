@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mtp/inplace_algorithm.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+template <typename T, std::size_t N>
+auto
+bench_set(std::string const& type) -> void
+{
+  auto const suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+  // posting list like sets: sorted unique IDs drawn from a universe about 4 times the capacity,
+  // so pairs intersect on roughly a quarter of their elements
+  auto rng = std::mt19937_64{ 5 };
+  auto inputs = std::vector<inplace_vector<T, N>>(512);
+  for (auto& ipv : inputs) {
+    auto ids = std::vector<T>{};
+    for (auto i = 0u; i < N; ++i) {
+      ids.push_back(static_cast<T>(rng() % (4 * N)));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    ipv.assign(ids.begin(), ids.end());
+  }
+
+  BENCHMARK("std::set_intersection" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, N>{};
+      std::set_intersection(inputs[i].begin(), inputs[i].end(), inputs[i + 1].begin(),
+                            inputs[i + 1].end(), std::back_inserter(out));
+      total += out.size();
+    }
+    return total;
+  };
+
+  BENCHMARK("mtp::set_intersection" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, N>{};
+      mtp::set_intersection(inputs[i], inputs[i + 1], out);
+      total += out.size();
+    }
+    return total;
+  };
+
+  BENCHMARK("std::set_union" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, 2 * N>{};
+      std::set_union(inputs[i].begin(), inputs[i].end(), inputs[i + 1].begin(),
+                     inputs[i + 1].end(), std::back_inserter(out));
+      total += out.size();
+    }
+    return total;
+  };
+
+  BENCHMARK("mtp::set_union" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, 2 * N>{};
+      mtp::set_union(inputs[i], inputs[i + 1], out);
+      total += out.size();
+    }
+    return total;
+  };
+
+  BENCHMARK("std::merge" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, 2 * N>{};
+      std::merge(inputs[i].begin(), inputs[i].end(), inputs[i + 1].begin(), inputs[i + 1].end(),
+                 std::back_inserter(out));
+      total += out.size();
+    }
+    return total;
+  };
+
+  BENCHMARK("mtp::merge" + suffix)
+  {
+    auto total = std::size_t{ 0 };
+    for (auto i = 0u; i + 1 < inputs.size(); ++i) {
+      auto out = inplace_vector<T, 2 * N>{};
+      mtp::merge(inputs[i], inputs[i + 1], out);
+      total += out.size();
+    }
+    return total;
+  };
+}
+
+} // namespace
+
+TEST_CASE("set operations", "[benchmark][inplace_algorithm]")
+{
+  bench_set<std::uint32_t, 64>("uint32_t");
+  bench_set<std::uint32_t, 256>("uint32_t");
+  bench_set<std::uint16_t, 256>("uint16_t");
+  bench_set<std::uint64_t, 256>("uint64_t");
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mtp/inplace_algorithm.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+template <typename T, std::size_t N>
+auto
+random_inputs(std::size_t count) -> std::vector<inplace_vector<T, N>>
+{
+  auto rng = std::mt19937_64{ 7 };
+  auto inputs = std::vector<inplace_vector<T, N>>(count);
+  for (auto& ipv : inputs) {
+    for (auto i = 0u; i < N; ++i) {
+      ipv.push_back(static_cast<T>(rng()));
+    }
+  }
+  return inputs;
+}
+
+template <typename T, std::size_t N>
+auto
+bench_sort(std::string const& type) -> void
+{
+  auto const suffix = "<" + type + ", " + std::to_string(N) + ">";
+
+  BENCHMARK_ADVANCED("std::sort" + suffix)(Catch::Benchmark::Chronometer meter)
+  {
+    auto inputs = random_inputs<T, N>(static_cast<std::size_t>(meter.runs()));
+    meter.measure([&](int i) {
+      auto& ipv = inputs[static_cast<std::size_t>(i)];
+      std::sort(ipv.begin(), ipv.end());
+      return ipv.front();
+    });
+  };
+
+  BENCHMARK_ADVANCED("mtp::sort" + suffix)(Catch::Benchmark::Chronometer meter)
+  {
+    auto inputs = random_inputs<T, N>(static_cast<std::size_t>(meter.runs()));
+    meter.measure([&](int i) {
+      auto& ipv = inputs[static_cast<std::size_t>(i)];
+      mtp::sort(ipv);
+      return ipv.front();
+    });
+  };
+}
+
+} // namespace
+
+TEST_CASE("sort", "[benchmark][inplace_algorithm]")
+{
+  bench_sort<int, 4>("int");
+  bench_sort<int, 8>("int");
+  bench_sort<int, 16>("int");
+  bench_sort<int, 32>("int");
+  bench_sort<int, 256>("int");
+  bench_sort<int, 4096>("int");
+  bench_sort<std::uint64_t, 16>("uint64_t");
+  bench_sort<std::uint64_t, 1024>("uint64_t");
+  bench_sort<float, 16>("float");
+  bench_sort<double, 32>("double");
+}
@@ -0,0 +1,182 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <mtp/inplace_spsc_queue.hpp>
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace {
+
+using mtp::inplace_spsc_queue;
+
+// producer and consumer on distinct cores so the numbers measure cache line transfers, not the
+// scheduler; stalled loops still yield so a single core machine makes progress
+auto
+pin_to(std::thread& t, unsigned cpu) -> void
+{
+#if defined(__linux__)
+  auto const cpus = std::thread::hardware_concurrency();
+  if (cpus < 2) {
+    return;
+  }
+  auto set = cpu_set_t{};
+  CPU_ZERO(&set);
+  CPU_SET(cpu % cpus, &set);
+  pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+  static_cast<void>(t);
+  static_cast<void>(cpu);
+#endif
+}
+
+template <typename Push, typename Pop>
+auto
+transfer(std::uint64_t count, Push push, Pop pop) -> std::uint64_t
+{
+  auto producer = std::thread([&] {
+    for (auto i = std::uint64_t{ 0 }; i < count;) {
+      auto const pushed = push(i);
+      if (pushed == 0) {
+        std::this_thread::yield();
+      }
+      i += pushed;
+    }
+  });
+  auto sum = std::uint64_t{ 0 };
+  auto consumer = std::thread([&] {
+    for (auto received = std::uint64_t{ 0 }; received < count;) {
+      auto const popped = pop(sum);
+      if (popped == 0) {
+        std::this_thread::yield();
+      }
+      received += popped;
+    }
+  });
+  pin_to(producer, 0);
+  pin_to(consumer, 1);
+  producer.join();
+  consumer.join();
+  return sum;
+}
+
+template <std::size_t N>
+auto
+bench_spsc() -> void
+{
+  constexpr auto count = std::uint64_t{ 1 } << 20;
+  constexpr auto batch = std::size_t{ 16 };
+  auto const suffix = "<uint64_t, " + std::to_string(N) + ">";
+
+  BENCHMARK("mutex deque throughput x 1M" + suffix)
+  {
+    auto mutex = std::mutex{};
+    auto queue = std::deque<std::uint64_t>{};
+    return transfer(
+        count,
+        [&](std::uint64_t i) -> std::uint64_t {
+          auto const lock = std::lock_guard(mutex);
+          if (queue.size() >= N) {
+            return 0;
+          }
+          queue.push_back(i);
+          return 1;
+        },
+        [&](std::uint64_t& sum) -> std::uint64_t {
+          auto const lock = std::lock_guard(mutex);
+          if (queue.empty()) {
+            return 0;
+          }
+          sum += queue.front();
+          queue.pop_front();
+          return 1;
+        });
+  };
+
+  BENCHMARK("inplace_spsc_queue throughput x 1M" + suffix)
+  {
+    auto queue = inplace_spsc_queue<std::uint64_t, N>{};
+    return transfer(
+        count, [&](std::uint64_t i) -> std::uint64_t { return queue.try_push(i); },
+        [&](std::uint64_t& sum) -> std::uint64_t {
+          auto value = std::uint64_t{};
+          if (!queue.try_pop(value)) {
+            return 0;
+          }
+          sum += value;
+          return 1;
+        });
+  };
+
+  BENCHMARK("inplace_spsc_queue batched throughput x 1M" + suffix)
+  {
+    auto queue = inplace_spsc_queue<std::uint64_t, N>{};
+    return transfer(
+        count,
+        [&](std::uint64_t i) -> std::uint64_t {
+          auto values = std::array<std::uint64_t, batch>{};
+          for (auto j = std::size_t{ 0 }; j < batch; ++j) {
+            values[j] = i + j;
+          }
+          auto const n = std::min<std::uint64_t>(batch, count - i);
+          return queue.push_batch(std::span(values).first(n));
+        },
+        [&](std::uint64_t& sum) -> std::uint64_t {
+          auto values = std::array<std::uint64_t, batch>{};
+          auto const n = queue.pop_batch(values);
+          for (auto j = std::size_t{ 0 }; j < n; ++j) {
+            sum += values[j];
+          }
+          return n;
+        });
+  };
+
+  // one way latency is half of a round trip between two queues
+  BENCHMARK("inplace_spsc_queue round trip x 10k" + suffix)
+  {
+    constexpr auto trips = std::uint64_t{ 10'000 };
+    auto ping = inplace_spsc_queue<std::uint64_t, N>{};
+    auto pong = inplace_spsc_queue<std::uint64_t, N>{};
+    auto echo = std::thread([&] {
+      for (auto i = std::uint64_t{ 0 }; i < trips; ++i) {
+        auto value = std::uint64_t{};
+        while (!ping.try_pop(value)) {
+          std::this_thread::yield();
+        }
+        while (!pong.try_push(value)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    pin_to(echo, 1);
+    auto sum = std::uint64_t{ 0 };
+    for (auto i = std::uint64_t{ 0 }; i < trips; ++i) {
+      while (!ping.try_push(i)) {
+        std::this_thread::yield();
+      }
+      auto value = std::uint64_t{};
+      while (!pong.try_pop(value)) {
+        std::this_thread::yield();
+      }
+      sum += value;
+    }
+    echo.join();
+    return sum;
+  };
+}
+
+} // namespace
+
+TEST_CASE("spsc queue", "[benchmark][inplace_spsc_queue]")
+{
+  bench_spsc<64>();
+  bench_spsc<1024>();
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mtp/inplace_ws_deque.hpp>
+
+namespace {
+
+using deque = mtp::inplace_ws_deque<std::uint32_t, 1024>;
+
+// Fork-join over a binary tree of tasks: a task of depth d forks a child of depth d - 1 onto the
+// worker's deque and continues as the other child. Idle workers steal half of a random victim's
+// deque. Returns the number of leaves, 2^depth.
+auto
+fork_join(unsigned threads, std::uint32_t depth) -> std::uint64_t
+{
+  auto const deques = std::make_unique<deque[]>(threads);
+  auto const leaves = std::uint64_t{ 1 } << depth;
+  auto done = std::atomic<std::uint64_t>{ 0 };
+
+  auto worker = [&](unsigned self) {
+    auto& own = deques[self];
+    auto local = std::uint64_t{ 0 };
+    auto seed = self * 2654435761u + 1;
+
+    auto const run = [&](auto const& run, std::uint32_t task) -> void {
+      for (; task > 0; --task) {
+        if (!own.try_push(task - 1)) {
+          run(run, task - 1);
+        }
+      }
+      ++local;
+    };
+
+    auto stolen = std::array<std::uint32_t, 32>{};
+    for (;;) {
+      if (auto task = std::uint32_t{}; own.try_pop(task)) {
+        run(run, task);
+        continue;
+      }
+      if (local > 0) {
+        done.fetch_add(local, std::memory_order_release);
+        local = 0;
+      }
+      if (done.load(std::memory_order_acquire) == leaves) {
+        return;
+      }
+
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      auto const victim = seed % threads;
+      auto const n = victim == self ? 0 : deques[victim].steal_half(stolen);
+      if (n == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (auto i = std::size_t{ 1 }; i < n; ++i) {
+        static_cast<void>(own.try_push(stolen[i]));
+      }
+      run(run, stolen[0]);
+    }
+  };
+
+  static_cast<void>(deques[0].try_push(depth));
+  auto pool = std::vector<std::thread>{};
+  for (auto t = 1u; t < threads; ++t) {
+    pool.emplace_back(worker, t);
+  }
+  worker(0);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  return done.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+TEST_CASE("work-stealing deque", "[benchmark][inplace_ws_deque]")
+{
+  constexpr auto depth = std::uint32_t{ 18 };
+  auto const nproc = std::max(1u, std::thread::hardware_concurrency());
+
+  // 1, 2, 4, ... up to and including nproc
+  for (auto threads = 1u;; threads = std::min(threads * 2, nproc)) {
+    BENCHMARK("fork-join 2^18 tasks on " + std::to_string(threads) + " threads")
+    {
+      return fork_join(threads, depth);
+    };
+    if (threads == nproc) {
+      break;
+    }
+  }
+}
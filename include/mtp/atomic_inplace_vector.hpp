@@ -0,0 +1,209 @@
+#ifndef MTP_ATOMIC_INPLACE_VECTOR_HPP
+#define MTP_ATOMIC_INPLACE_VECTOR_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+// Fixed capacity append buffer for many producers and one consumer. A producer reserves slots
+// with a single `fetch_add` on the reserved count (k of them for a batch), constructs its elements
+// and marks each slot ready with a release store. The consumer sees the longest prefix of ready
+// slots through `committed()`, and `drain_into` relocates the whole buffer into an
+// `inplace_vector`, after which producers start over at slot 0.
+//
+// A reserved slot has to become ready, so construction must not throw: producers require nothrow
+// construction from their arguments.
+template <typename T, std::size_t N>
+  requires(N > 0 && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+class atomic_inplace_vector : private detail::ipv::storage::byte_storage<T, N>
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  using _storage = detail::ipv::storage::byte_storage<T, N>;
+  static constexpr auto _line = detail::ipv::concurrency::cache_line_size;
+
+  // may run past N while full or sealed, slots at and after N are never handed out
+  alignas(_line) std::atomic<size_type> _reserved{ 0 };
+  alignas(_line) std::array<std::atomic<bool>, N> _ready{};
+  size_type _visible{ 0 }; // consumer side: slots known to be ready
+
+  // first slot and number of slots granted to a reservation of `count`, possibly fewer
+  [[nodiscard]] auto
+  _reserve(size_type count) noexcept -> std::pair<size_type, size_type>
+  {
+    // a full buffer does not keep bumping the counter
+    if (count == 0 || _reserved.load(std::memory_order_relaxed) >= N)
+      MTP_UNLIKELY
+      {
+        return { N, 0 };
+      }
+    // acquire orders the slot writes after the reset done by the last `drain_into`
+    auto const first = _reserved.fetch_add(count, std::memory_order_acquire);
+    if (first >= N)
+      MTP_UNLIKELY
+      {
+        return { N, 0 };
+      }
+    return { first, std::min(count, N - first) };
+  }
+
+  auto
+  _commit(size_type first, size_type count) noexcept -> void
+  {
+    for (auto i = first; i < first + count; ++i) {
+      _ready[i].store(true, std::memory_order_release);
+    }
+  }
+
+public:
+  atomic_inplace_vector() noexcept = default;
+
+  atomic_inplace_vector(atomic_inplace_vector const&) = delete;
+  auto operator=(atomic_inplace_vector const&) -> atomic_inplace_vector& = delete;
+
+  ~atomic_inplace_vector()
+  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      std::destroy_n(_storage::data(), size());
+    }
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  // reserved slots, a snapshot that may include elements still being written
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return std::min(_reserved.load(std::memory_order_acquire), N);
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  // producers
+
+  template <typename... Args>
+    requires(std::is_nothrow_constructible_v<T, Args...>)
+  auto
+  try_emplace(Args&&... args) noexcept -> bool
+  {
+    auto const [first, count] = _reserve(1);
+    if (count == 0)
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    std::construct_at(_storage::data() + first, std::forward<Args>(args)...);
+    _commit(first, 1);
+    return true;
+  }
+
+  auto
+  try_push(T const& value) noexcept -> bool
+    requires(std::is_nothrow_copy_constructible_v<T>)
+  {
+    return try_emplace(value);
+  }
+
+  auto
+  try_push(T&& value) noexcept -> bool
+  {
+    return try_emplace(std::move(value));
+  }
+
+  // Reserves `values.size()` slots with one `fetch_add` and copies the longest prefix that fits.
+  // Returns the number appended.
+  auto
+  push_batch(std::span<T const> values) noexcept -> size_type
+    requires(std::is_nothrow_copy_constructible_v<T>)
+  {
+    auto const [first, count] = _reserve(values.size());
+    std::uninitialized_copy_n(values.data(), count, _storage::data() + first);
+    _commit(first, count);
+    return count;
+  }
+
+  // consumer
+
+  // The longest prefix whose elements are all written, it only grows until the next `drain_into`.
+  [[nodiscard]] auto
+  committed() noexcept -> std::span<T const>
+  {
+    auto const reserved = size();
+    while (_visible < reserved && _ready[_visible].load(std::memory_order_acquire)) {
+      ++_visible;
+    }
+    return { _storage::data(), _visible };
+  }
+
+  // Relocates as many elements as fit into the back of `out`, concurrently with producers: the
+  // reserved count is sealed at N (reservations fail while draining), in-flight producers are
+  // waited for, elements that do not fit move to the front of the buffer, in order, and the other
+  // slots are handed back with one release store. Returns the number of elements moved.
+  template <std::size_t M>
+  auto
+  drain_into(inplace_vector<T, M>& out) noexcept -> size_type
+  {
+    auto const count = std::min(_reserved.exchange(N, std::memory_order_acquire), N);
+
+    for (auto i = _visible; i < count; ++i) {
+      while (!_ready[i].load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+    }
+
+    using detail::ipv::memory::uninitialized_relocate_n;
+    auto const first = _storage::data();
+    auto const moved = std::min(count, M - out.size());
+    if (moved > 0) {
+      uninitialized_relocate_n(first, moved, out.data() + out.size());
+      detail::ipv::access::set_size(out, out.size() + moved);
+    }
+
+    // the leftovers stay ready, in slots [0, kept)
+    auto const kept = count - moved;
+    if (kept > 0 && moved > 0) {
+      uninitialized_relocate_n(first + moved, kept, first);
+    }
+    for (auto i = kept; i < count; ++i) {
+      _ready[i].store(false, std::memory_order_relaxed);
+    }
+    _visible = kept;
+    _reserved.store(kept, std::memory_order_release);
+    return moved;
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_UNLIKELY
+
+#endif // MTP_ATOMIC_INPLACE_VECTOR_HPP
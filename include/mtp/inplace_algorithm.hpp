@@ -0,0 +1,733 @@
+#ifndef MTP_INPLACE_ALGORITHM_HPP
+#define MTP_INPLACE_ALGORITHM_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <immintrin.h>
+#endif
+
+namespace mtp {
+
+namespace detail::ipa::sort {
+
+// Batcher odd-even merge sort network for the next power of two, with comparators that touch
+// indices >= N dropped. Dropping is exact when the slots past N hold the greatest value: such a
+// comparator would never swap.
+template <std::size_t N>
+consteval auto
+network_size() -> std::size_t
+{
+  constexpr auto n = std::bit_ceil(N);
+  auto count = std::size_t{ 0 };
+  for (auto p = std::size_t{ 1 }; p < n; p <<= 1) {
+    for (auto k = p; k >= 1; k >>= 1) {
+      for (auto j = k % p; j + k < n; j += 2 * k) {
+        for (auto i = std::size_t{ 0 }; i < std::min(k, n - j - k); ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < N) {
+            ++count;
+          }
+        }
+      }
+    }
+  }
+  return count;
+}
+
+template <std::size_t N>
+consteval auto
+make_network() -> std::array<std::pair<std::uint8_t, std::uint8_t>, network_size<N>()>
+{
+  constexpr auto n = std::bit_ceil(N);
+  auto network = std::array<std::pair<std::uint8_t, std::uint8_t>, network_size<N>()>{};
+  auto it = network.begin();
+  for (auto p = std::size_t{ 1 }; p < n; p <<= 1) {
+    for (auto k = p; k >= 1; k >>= 1) {
+      for (auto j = k % p; j + k < n; j += 2 * k) {
+        for (auto i = std::size_t{ 0 }; i < std::min(k, n - j - k); ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < N) {
+            *it++ = { static_cast<std::uint8_t>(i + j), static_cast<std::uint8_t>(i + j + k) };
+          }
+        }
+      }
+    }
+  }
+  return network;
+}
+
+template <std::size_t N>
+inline constexpr auto network = make_network<N>();
+
+inline constexpr auto max_network_size = std::size_t{ 32 };
+
+// radix sort pays for 256-bucket histograms, below this many elements comparison sorts win
+inline constexpr auto min_radix_size = std::size_t{ 128 };
+
+// largest scratch buffer put on the stack for radix sort
+inline constexpr auto max_radix_scratch_bytes = std::size_t{ 64 * 1024 };
+
+template <typename T>
+inline constexpr bool is_network_sortable_v =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+inline constexpr bool is_radix_sortable_v =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+template <typename T>
+constexpr auto
+compare_exchange(T* data, std::size_t i, std::size_t j) noexcept -> void
+{
+  auto const a = data[i];
+  auto const b = data[j];
+  if constexpr (std::is_integral_v<T>) {
+    // masked xor swap, GCC turns min/max on integers back into branches
+    using U = std::make_unsigned_t<T>;
+    auto const mask = static_cast<U>(-static_cast<U>(b < a));
+    auto const diff = static_cast<U>((static_cast<U>(a) ^ static_cast<U>(b)) & mask);
+    data[i] = static_cast<T>(static_cast<U>(a) ^ diff);
+    data[j] = static_cast<T>(static_cast<U>(b) ^ diff);
+  }
+  else {
+    data[i] = std::min(a, b);
+    data[j] = std::max(a, b);
+  }
+}
+
+template <std::size_t N, typename T>
+auto
+network_sort(T* data, std::size_t size) noexcept -> void
+{
+  // work on a local copy so the fully unrolled network can stay in registers
+  MTP_EXPECTS(size <= N);
+  using limits = std::numeric_limits<T>;
+  T values[N];
+  std::copy_n(data, size, values);
+  std::fill(values + size, values + N, limits::has_infinity ? limits::infinity() : limits::max());
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    (compare_exchange(values, network<N>[I].first, network<N>[I].second), ...);
+  }(std::make_index_sequence<network<N>.size()>{});
+  std::copy_n(values, size, data);
+}
+
+template <typename T>
+constexpr auto
+radix_key(T value) noexcept
+{
+  using U = std::make_unsigned_t<T>;
+  if constexpr (std::is_signed_v<T>) {
+    return static_cast<U>(static_cast<U>(value) ^ (U{ 1 } << (sizeof(T) * 8 - 1)));
+  }
+  else {
+    return static_cast<U>(value);
+  }
+}
+
+// LSD radix sort on bytes, all histograms gathered in one pass and passes where every key shares
+// the same byte skipped
+template <std::size_t N, typename T>
+auto
+radix_sort(T* data, std::size_t size) noexcept -> void
+{
+  constexpr auto passes = sizeof(T);
+  std::size_t counts[passes][256] = {};
+  for (auto i = std::size_t{ 0 }; i < size; ++i) {
+    auto const key = radix_key(data[i]);
+    for (auto pass = std::size_t{ 0 }; pass < passes; ++pass) {
+      ++counts[pass][(key >> (pass * 8)) & 0xff];
+    }
+  }
+
+  T scratch[N];
+  auto src = data;
+  auto dst = static_cast<T*>(scratch);
+  for (auto pass = std::size_t{ 0 }; pass < passes; ++pass) {
+    auto& count = counts[pass];
+    if (count[(radix_key(src[0]) >> (pass * 8)) & 0xff] == size) {
+      continue;
+    }
+
+    auto offset = std::size_t{ 0 };
+    for (auto& c : count) {
+      offset += std::exchange(c, offset);
+    }
+    for (auto i = std::size_t{ 0 }; i < size; ++i) {
+      dst[count[(radix_key(src[i]) >> (pass * 8)) & 0xff]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    std::copy_n(src, size, data);
+  }
+}
+
+} // namespace detail::ipa::sort
+
+// Sorts ascending, picking the kernel from the compile time capacity: a branchless sorting
+// network (over the whole padded buffer) for arithmetic T and N <= 32, LSD radix sort with inline
+// scratch for larger integral vectors, and `std::sort` otherwise.
+template <typename T, std::size_t N>
+constexpr auto
+sort(inplace_vector<T, N>& ipv) -> void
+{
+  namespace s = detail::ipa::sort;
+
+  if (ipv.size() < 2) {
+    return;
+  }
+
+  if (!std::is_constant_evaluated()) {
+    // below two elements there is nothing to compare, and no network to unroll
+    if constexpr (s::is_network_sortable_v<T> && N >= 2 && N <= s::max_network_size) {
+      s::network_sort<N>(ipv.data(), ipv.size());
+      return;
+    }
+    else if constexpr (s::is_radix_sortable_v<T> && N * sizeof(T) <= s::max_radix_scratch_bytes) {
+      if (ipv.size() >= s::min_radix_size) {
+        s::radix_sort<N>(ipv.data(), ipv.size());
+        return;
+      }
+    }
+  }
+
+  MTP_EXPECTS(ipv.size() <= N);
+  std::sort(ipv.begin(), ipv.end());
+}
+
+template <typename T, std::size_t N, typename Compare>
+constexpr auto
+sort(inplace_vector<T, N>& ipv, Compare comp) -> void
+{
+  std::sort(ipv.begin(), ipv.end(), comp);
+}
+
+namespace detail::ipa::search {
+
+#if defined(__AVX2__)
+inline constexpr auto vector_bytes = std::size_t{ 32 };
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+inline constexpr auto vector_bytes = std::size_t{ 16 };
+#else
+inline constexpr auto vector_bytes = std::size_t{ 0 };
+#endif
+
+// 64-bit integer compares need AVX2, emulating them with SSE2 is no faster than scalar code
+template <typename T>
+inline constexpr bool is_simd_searchable_v =
+    vector_bytes > 0 &&
+    (((std::is_integral_v<T> || std::is_enum_v<T>) && (sizeof(T) < 8 || vector_bytes >= 32)) ||
+     std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// counting popcounts every block mask, a software popcount loses to the compiler's own
+// vectorization of `std::count`
+#if defined(__POPCNT__)
+inline constexpr bool has_popcount = true;
+#else
+inline constexpr bool has_popcount = false;
+#endif
+
+template <std::size_t Size>
+using bits_t = std::conditional_t<
+    Size == 1, std::uint8_t,
+    std::conditional_t<Size == 2, std::uint16_t,
+                       std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+#if defined(__AVX2__)
+// one bit per byte, all bytes of a lane are set when the lane matches
+template <typename T>
+inline auto
+match_mask(T const* p, T value) noexcept -> std::uint32_t
+{
+  if constexpr (std::is_same_v<T, float>) {
+    auto const block = _mm256_loadu_ps(p);
+    auto const eq = _mm256_cmp_ps(block, _mm256_set1_ps(value), _CMP_EQ_OQ);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(eq)));
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    auto const block = _mm256_loadu_pd(p);
+    auto const eq = _mm256_cmp_pd(block, _mm256_set1_pd(value), _CMP_EQ_OQ);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(eq)));
+  }
+  else {
+    auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    auto const bits = std::bit_cast<bits_t<sizeof(T)>>(value);
+    auto eq = __m256i{};
+    if constexpr (sizeof(T) == 1) {
+      eq = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(bits)));
+    }
+    else if constexpr (sizeof(T) == 2) {
+      eq = _mm256_cmpeq_epi16(block, _mm256_set1_epi16(static_cast<short>(bits)));
+    }
+    else if constexpr (sizeof(T) == 4) {
+      eq = _mm256_cmpeq_epi32(block, _mm256_set1_epi32(static_cast<int>(bits)));
+    }
+    else {
+      eq = _mm256_cmpeq_epi64(block, _mm256_set1_epi64x(static_cast<long long>(bits)));
+    }
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+  }
+}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// one bit per byte, all bytes of a lane are set when the lane matches
+template <typename T>
+inline auto
+match_mask(T const* p, T value) noexcept -> std::uint32_t
+{
+  if constexpr (std::is_same_v<T, float>) {
+    auto const eq = _mm_cmpeq_ps(_mm_loadu_ps(p), _mm_set1_ps(value));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castps_si128(eq)));
+  }
+  else if constexpr (std::is_same_v<T, double>) {
+    auto const eq = _mm_cmpeq_pd(_mm_loadu_pd(p), _mm_set1_pd(value));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(eq)));
+  }
+  else {
+    auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    auto const bits = std::bit_cast<bits_t<sizeof(T)>>(value);
+    auto eq = __m128i{};
+    if constexpr (sizeof(T) == 1) {
+      eq = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(bits)));
+    }
+    else if constexpr (sizeof(T) == 2) {
+      eq = _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(bits)));
+    }
+    else if constexpr (sizeof(T) == 4) {
+      eq = _mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int>(bits)));
+    }
+    else {
+      static_assert(sizeof(T) <= 4, "64-bit lanes are not searched with SSE2");
+    }
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+  }
+}
+#endif
+
+// Whole vector blocks are loaded as long as they stay inside the N element inline buffer, even
+// past `size`; lanes past `size` are masked off. Only a block that would leave the buffer (when
+// N * sizeof(T) is not a multiple of the vector width) falls back to scalar code.
+template <std::size_t N, typename T>
+inline auto
+find_index(T const* data, std::size_t size, T value) noexcept -> std::size_t
+{
+  constexpr auto lanes = vector_bytes / sizeof(T);
+  auto i = std::size_t{ 0 };
+  for (; i < size && i + lanes <= N; i += lanes) {
+    auto mask = match_mask(data + i, value);
+    if (auto const valid = size - i; valid < lanes) {
+      mask &= (std::uint32_t{ 1 } << (valid * sizeof(T))) - 1;
+    }
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+    }
+  }
+  for (; i < size; ++i) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <std::size_t N, typename T>
+inline auto
+count(T const* data, std::size_t size, T value) noexcept -> std::size_t
+{
+  constexpr auto lanes = vector_bytes / sizeof(T);
+  auto matched_bytes = std::size_t{ 0 };
+  auto i = std::size_t{ 0 };
+  for (; i < size && i + lanes <= N; i += lanes) {
+    auto mask = match_mask(data + i, value);
+    if (auto const valid = size - i; valid < lanes) {
+      mask &= (std::uint32_t{ 1 } << (valid * sizeof(T))) - 1;
+    }
+    matched_bytes += static_cast<std::size_t>(std::popcount(mask));
+  }
+  auto result = matched_bytes / sizeof(T);
+  for (; i < size; ++i) {
+    result += data[i] == value;
+  }
+  return result;
+}
+
+} // namespace detail::ipa::search
+
+// Position of the first element equal to `value`, or `size()` if there is none. Arithmetic and
+// enum elements use an SSE2/AVX2 kernel (picked at compile time) that exploits the fixed
+// capacity to scan whole vectors; other types use `std::find`.
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr auto
+index_of(inplace_vector<T, N> const& ipv, std::type_identity_t<T> const& value) noexcept
+    -> std::size_t
+{
+  if (!std::is_constant_evaluated()) {
+    if constexpr (detail::ipa::search::is_simd_searchable_v<T>) {
+      return detail::ipa::search::find_index<N>(ipv.data(), ipv.size(), value);
+    }
+  }
+  return static_cast<std::size_t>(std::find(ipv.begin(), ipv.end(), value) - ipv.begin());
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr auto
+find(inplace_vector<T, N>& ipv, std::type_identity_t<T> const& value) noexcept
+    -> typename inplace_vector<T, N>::iterator
+{
+  return ipv.begin() + index_of(std::as_const(ipv), value);
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr auto
+find(inplace_vector<T, N> const& ipv, std::type_identity_t<T> const& value) noexcept
+    -> typename inplace_vector<T, N>::const_iterator
+{
+  return ipv.begin() + index_of(ipv, value);
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr auto
+contains(inplace_vector<T, N> const& ipv, std::type_identity_t<T> const& value) noexcept -> bool
+{
+  return index_of(ipv, value) != ipv.size();
+}
+
+template <typename T, std::size_t N>
+[[nodiscard]] constexpr auto
+count(inplace_vector<T, N> const& ipv, std::type_identity_t<T> const& value) noexcept
+    -> std::size_t
+{
+  if (!std::is_constant_evaluated()) {
+    if constexpr (detail::ipa::search::is_simd_searchable_v<T> &&
+                  detail::ipa::search::has_popcount) {
+      return detail::ipa::search::count<N>(ipv.data(), ipv.size(), value);
+    }
+  }
+  return static_cast<std::size_t>(std::count(ipv.begin(), ipv.end(), value));
+}
+
+namespace detail::ipa::set {
+
+// 16-bit and 32-bit integers are compared all-against-all in 128-bit blocks; narrower lanes need
+// too many rotations and 64-bit compares need SSE4.1
+template <typename T>
+inline constexpr bool is_simd_intersectable_v =
+    search::vector_bytes > 0 && (std::is_integral_v<T> || std::is_enum_v<T>) &&
+    (sizeof(T) == 2 || sizeof(T) == 4);
+
+// arithmetic elements take the branchless merge loops
+template <typename T>
+inline constexpr bool is_branchless_v = std::is_arithmetic_v<T>;
+
+// the block kernel assumes sets; written without early exit so the compiler can vectorize it
+template <typename T>
+constexpr auto
+is_strictly_increasing(T const* data, std::size_t size) noexcept -> bool
+{
+  auto unordered = false;
+  for (auto i = std::size_t{ 1 }; i < size; ++i) {
+    unordered |= !(data[i - 1] < data[i]);
+  }
+  return !unordered;
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+template <int Bytes>
+inline auto
+rotate(__m128i v) noexcept -> __m128i
+{
+  return _mm_or_si128(_mm_srli_si128(v, Bytes), _mm_slli_si128(v, 16 - Bytes));
+}
+
+// one bit per lane of `a`, set when the lane equals any lane of `b`
+template <typename T>
+inline auto
+block_matches(T const* a, T const* b) noexcept -> std::uint32_t
+{
+  constexpr auto lanes = 16 / sizeof(T);
+  auto const va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a));
+  auto const vb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b));
+  auto eq = _mm_setzero_si128();
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    if constexpr (sizeof(T) == 4) {
+      ((eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, rotate<static_cast<int>(I * 4)>(vb)))), ...);
+    }
+    else {
+      ((eq = _mm_or_si128(eq, _mm_cmpeq_epi16(va, rotate<static_cast<int>(I * 2)>(vb)))), ...);
+    }
+  }(std::make_index_sequence<lanes>{});
+
+  if constexpr (sizeof(T) == 4) {
+    return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+  }
+  else {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(eq, _mm_setzero_si128())));
+  }
+}
+#endif
+
+// `emit` appends one element and returns false once the destination is full
+template <typename T, typename Emit>
+constexpr auto
+intersection(T const* a, std::size_t na, T const* b, std::size_t nb, Emit emit) -> bool
+{
+  auto i = std::size_t{ 0 };
+  auto j = std::size_t{ 0 };
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      ++i;
+    }
+    else if (b[j] < a[i]) {
+      ++j;
+    }
+    else {
+      if (!emit(a[i])) {
+        return false;
+      }
+      ++i;
+      ++j;
+    }
+  }
+  return true;
+}
+
+// Schlegel style block intersection of two strictly increasing inputs: every lane of a block of
+// `a` is compared with every lane of a block of `b`, then the block with the smaller last element
+// (or both) advances. The remainders go through the scalar loop.
+template <typename T, typename Emit>
+inline auto
+simd_intersection(T const* a, std::size_t na, T const* b, std::size_t nb, Emit emit) -> void
+{
+  constexpr auto lanes = 16 / sizeof(T);
+  auto i = std::size_t{ 0 };
+  auto j = std::size_t{ 0 };
+  while (i + lanes <= na && j + lanes <= nb) {
+    for (auto mask = block_matches(a + i, b + j); mask != 0; mask &= mask - 1) {
+      emit(a[i + static_cast<std::size_t>(std::countr_zero(mask))]);
+    }
+    auto const a_last = a[i + lanes - 1];
+    auto const b_last = b[j + lanes - 1];
+    i += a_last <= b_last ? lanes : 0;
+    j += b_last <= a_last ? lanes : 0;
+  }
+  intersection(a + i, na - i, b + j, nb - j, emit);
+}
+
+template <typename T, typename Emit>
+constexpr auto
+emit_rest(T const* first, T const* last, Emit emit) -> bool
+{
+  for (; first != last; ++first) {
+    if (!emit(*first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename Emit>
+constexpr auto
+union_(T const* a, std::size_t na, T const* b, std::size_t nb, Emit emit) -> bool
+{
+  auto i = std::size_t{ 0 };
+  auto j = std::size_t{ 0 };
+  while (i < na && j < nb) {
+    auto const& x = a[i];
+    auto const& y = b[j];
+    auto const take_b = y < x;
+    auto const take_a = x < y;
+    if constexpr (is_branchless_v<T>) {
+      if (!emit(take_b ? y : x)) {
+        return false;
+      }
+      i += !take_b;
+      j += !take_a;
+    }
+    else if (take_b) {
+      if (!emit(y)) {
+        return false;
+      }
+      ++j;
+    }
+    else {
+      if (!emit(x)) {
+        return false;
+      }
+      ++i;
+      j += !take_a;
+    }
+  }
+  return emit_rest(a + i, a + na, emit) && emit_rest(b + j, b + nb, emit);
+}
+
+// stable, equal elements of `a` come first
+template <typename T, typename Emit>
+constexpr auto
+merge(T const* a, std::size_t na, T const* b, std::size_t nb, Emit emit) -> bool
+{
+  auto i = std::size_t{ 0 };
+  auto j = std::size_t{ 0 };
+  while (i < na && j < nb) {
+    auto const take_b = b[j] < a[i];
+    if constexpr (is_branchless_v<T>) {
+      if (!emit(take_b ? b[j] : a[i])) {
+        return false;
+      }
+      i += !take_b;
+      j += take_b;
+    }
+    else if (!emit(take_b ? b[j++] : a[i++])) {
+      return false;
+    }
+  }
+  return emit_rest(a + i, a + na, emit) && emit_rest(b + j, b + nb, emit);
+}
+
+// Runs `op` unchecked when `bound` more elements are guaranteed to fit in `out`, and with a
+// capacity check per element otherwise.
+template <typename T, std::size_t N, typename Op>
+constexpr auto
+into(inplace_vector<T, N>& out, std::size_t bound, Op op) -> bool
+{
+  if (bound <= N - out.size()) {
+    op([&out](T const& value) {
+      out.unchecked_push_back(value);
+      return true;
+    });
+    return true;
+  }
+  return op([&out](T const& value) { return out.try_push_back(value) != nullptr; });
+}
+
+} // namespace detail::ipa::set
+
+// Set operations on sorted ranges with the semantics of their `std::` counterparts (including
+// duplicates), appending to `out`, which must not be one of the inputs. The output is built in
+// place with unchecked construction whenever the worst case result fits the remaining capacity.
+// The `try_` forms return false on overflow, leaving the part of the result that fit in `out`;
+// the others throw `std::bad_alloc`.
+//
+// Intersections of 16-bit and 32-bit integer sets (strictly increasing inputs) use an SSE2 block
+// compare kernel.
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+try_set_intersection(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b,
+                     inplace_vector<T, N>& out) -> bool
+{
+  namespace s = detail::ipa::set;
+
+  auto const bound = std::min(a.size(), b.size());
+  if constexpr (s::is_simd_intersectable_v<T>) {
+    if (!std::is_constant_evaluated() && bound <= N - out.size() &&
+        s::is_strictly_increasing(a.data(), a.size()) &&
+        s::is_strictly_increasing(b.data(), b.size())) {
+      s::simd_intersection(a.data(), a.size(), b.data(), b.size(), [&out](T const& value) {
+        out.unchecked_push_back(value);
+        return true;
+      });
+      return true;
+    }
+  }
+  return s::into(out, bound, [&](auto emit) {
+    return s::intersection(a.data(), a.size(), b.data(), b.size(), emit);
+  });
+}
+
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+try_set_union(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b,
+              inplace_vector<T, N>& out) -> bool
+{
+  namespace s = detail::ipa::set;
+  return s::into(out, a.size() + b.size(), [&](auto emit) {
+    return s::union_(a.data(), a.size(), b.data(), b.size(), emit);
+  });
+}
+
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+try_merge(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b, inplace_vector<T, N>& out)
+    -> bool
+{
+  namespace s = detail::ipa::set;
+  return s::into(out, a.size() + b.size(), [&](auto emit) {
+    return s::merge(a.data(), a.size(), b.data(), b.size(), emit);
+  });
+}
+
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+set_intersection(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b,
+                 inplace_vector<T, N>& out) -> void
+{
+  if (!try_set_intersection(a, b, out))
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+    }
+}
+
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+set_union(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b,
+          inplace_vector<T, N>& out) -> void
+{
+  if (!try_set_union(a, b, out))
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+    }
+}
+
+template <typename T, std::size_t NA, std::size_t NB, std::size_t N>
+constexpr auto
+merge(inplace_vector<T, NA> const& a, inplace_vector<T, NB> const& b, inplace_vector<T, N>& out)
+    -> void
+{
+  if (!try_merge(a, b, out))
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+    }
+}
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_ALGORITHM_HPP
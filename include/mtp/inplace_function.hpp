@@ -0,0 +1,285 @@
+#ifndef MTP_INPLACE_FUNCTION_HPP
+#define MTP_INPLACE_FUNCTION_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+namespace detail::ipf {
+
+template <typename R, typename... Args>
+struct vtable
+{
+  R (*invoke)(void*, Args&&...);
+  void (*copy)(void*, void const*);
+  void (*relocate)(void*, void*) noexcept;
+  void (*destroy)(void*) noexcept;
+  std::size_t size; // bytes copied by a trivial relocation
+};
+
+template <typename F, typename R, typename... Args>
+struct target
+{
+  static auto
+  invoke(void* p, Args&&... args) -> R
+  {
+    if constexpr (std::is_void_v<R>) {
+      std::invoke(*static_cast<F*>(p), std::forward<Args>(args)...);
+    }
+    else {
+      return std::invoke(*static_cast<F*>(p), std::forward<Args>(args)...);
+    }
+  }
+
+  static auto
+  copy(void* dest, void const* src) -> void
+  {
+    ::new (dest) F(*static_cast<F const*>(src));
+  }
+
+  static auto
+  relocate(void* dest, void* src) noexcept -> void
+  {
+    detail::ipv::memory::relocate_at(static_cast<F*>(dest), static_cast<F*>(src));
+  }
+
+  static auto
+  destroy(void* p) noexcept -> void
+  {
+    std::destroy_at(static_cast<F*>(p));
+  }
+
+  // null entries take the fast paths: trivially relocatable targets move as bytes and trivially
+  // destructible ones skip the indirect destroy call
+  static constexpr auto table = vtable<R, Args...>{
+    &invoke,
+    &copy,
+    is_trivially_relocatable_v<F> ? nullptr : &relocate,
+    std::is_trivially_destructible_v<F> ? nullptr : &destroy,
+    std::is_empty_v<F> ? 0 : sizeof(F), // the byte of an empty target is never initialized
+  };
+};
+
+} // namespace detail::ipf
+
+template <typename Sig, std::size_t Bytes = 4 * sizeof(void*),
+          std::size_t Align = alignof(std::max_align_t), bool TriviallyRelocatable = true>
+class inplace_function;
+
+// Non-allocating `std::function` replacement. Targets live in the `Bytes` inline buffer. By
+// default they are required to be trivially relocatable, so the wrapper itself is trivially
+// relocatable and moves (and containers of it shift) by copying bytes. With
+// `TriviallyRelocatable = false` any nothrow movable target is accepted (say a lambda capturing a
+// `std::string`) and those that are not trivially relocatable move through their vtable.
+template <typename R, typename... Args, std::size_t Bytes, std::size_t Align,
+          bool TriviallyRelocatable>
+class inplace_function<R(Args...), Bytes, Align, TriviallyRelocatable>
+{
+public:
+  using result_type = R;
+
+private:
+  using _vtable_type = detail::ipf::vtable<R, Args...>;
+
+  _vtable_type const* _vtable{ nullptr };
+  alignas(Align) std::byte _buffer[Bytes];
+
+  template <typename F>
+  static constexpr auto _is_target = !std::is_same_v<std::remove_cvref_t<F>, inplace_function> &&
+                                     std::is_invocable_r_v<R, std::decay_t<F>&, Args...>;
+
+  auto
+  _relocate_from(inplace_function& other) noexcept -> void
+  {
+    if (other._vtable) {
+      if (!TriviallyRelocatable && other._vtable->relocate) {
+        other._vtable->relocate(_buffer, other._buffer);
+      }
+      else {
+        std::memcpy(_buffer, other._buffer, other._vtable->size);
+      }
+    }
+    _vtable = std::exchange(other._vtable, nullptr);
+  }
+
+public:
+  inplace_function() noexcept = default;
+
+  inplace_function(std::nullptr_t) noexcept {}
+
+  template <typename F>
+    requires(_is_target<F>)
+  inplace_function(F&& f)
+  {
+    using T = std::decay_t<F>;
+    static_assert(sizeof(T) <= Bytes, "mtp::inplace_function: callable does not fit in buffer");
+    static_assert(Align % alignof(T) == 0, "mtp::inplace_function: callable is over-aligned");
+    static_assert(!TriviallyRelocatable || is_trivially_relocatable_v<T>,
+                  "mtp::inplace_function: callable must be trivially relocatable "
+                  "(specialize mtp::is_trivially_relocatable if it is, or use "
+                  "TriviallyRelocatable = false)");
+    static_assert(std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>,
+                  "mtp::inplace_function: callable must be nothrow move constructible");
+    static_assert(std::is_copy_constructible_v<T>,
+                  "mtp::inplace_function: callable must be copy constructible");
+
+    ::new (static_cast<void*>(_buffer)) T(std::forward<F>(f));
+    _vtable = &detail::ipf::target<T, R, Args...>::table;
+  }
+
+  inplace_function(inplace_function const& other)
+  {
+    if (other._vtable) {
+      other._vtable->copy(_buffer, other._buffer);
+      _vtable = other._vtable;
+    }
+  }
+
+  inplace_function(inplace_function&& other) noexcept
+  {
+    _relocate_from(other);
+  }
+
+  auto
+  operator=(inplace_function const& other) -> inplace_function&
+  {
+    if (this != std::addressof(other)) {
+      auto tmp = other;
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+
+  auto
+  operator=(inplace_function&& other) noexcept -> inplace_function&
+  {
+    if (this != std::addressof(other)) {
+      reset();
+      _relocate_from(other);
+    }
+    return *this;
+  }
+
+  auto
+  operator=(std::nullptr_t) noexcept -> inplace_function&
+  {
+    reset();
+    return *this;
+  }
+
+  template <typename F>
+    requires(_is_target<F>)
+  auto
+  operator=(F&& f) -> inplace_function&
+  {
+    return *this = inplace_function(std::forward<F>(f));
+  }
+
+  ~inplace_function()
+  {
+    reset();
+  }
+
+  auto
+  reset() noexcept -> void
+  {
+    if (_vtable && _vtable->destroy) {
+      _vtable->destroy(_buffer);
+    }
+    _vtable = nullptr;
+  }
+
+  auto
+  operator()(Args... args) const -> R
+  {
+    if (!_vtable)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_function_call());
+      }
+    MTP_EXPECTS(_vtable != nullptr);
+    // like `std::function`, a const call may invoke a non-const target
+    return _vtable->invoke(const_cast<std::byte*>(_buffer), std::forward<Args>(args)...);
+  }
+
+  [[nodiscard]] explicit
+  operator bool() const noexcept
+  {
+    return _vtable != nullptr;
+  }
+
+  [[nodiscard]] static constexpr auto
+  buffer_size() noexcept -> std::size_t
+  {
+    return Bytes;
+  }
+
+  auto
+  swap(inplace_function& other) noexcept -> void
+  {
+    if (this == std::addressof(other))
+      MTP_UNLIKELY
+      {
+        return;
+      }
+
+    auto tmp = inplace_function{};
+    tmp._relocate_from(other);
+    other._relocate_from(*this);
+    _relocate_from(tmp);
+  }
+
+  [[nodiscard]] friend auto
+  operator==(inplace_function const& f, std::nullptr_t) noexcept -> bool
+  {
+    return !f;
+  }
+
+  friend auto
+  swap(inplace_function& a, inplace_function& b) noexcept -> void
+  {
+    a.swap(b);
+  }
+};
+
+template <typename Sig, std::size_t Bytes, std::size_t Align>
+struct is_trivially_relocatable<inplace_function<Sig, Bytes, Align, true>> : std::true_type
+{};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_FUNCTION_HPP
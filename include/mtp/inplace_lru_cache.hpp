@@ -0,0 +1,277 @@
+#ifndef MTP_INPLACE_LRU_CACHE_HPP
+#define MTP_INPLACE_LRU_CACHE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+namespace detail::lru {
+
+// keys that compare bitwise and fit a vector lane; probing them scans whole blocks without early
+// exit so the compiler can vectorize the compare
+template <typename K>
+inline constexpr bool is_block_probed_v =
+    (std::is_integral_v<K> || std::is_enum_v<K> || std::is_pointer_v<K>) && sizeof(K) <= 8;
+
+inline constexpr auto block_width = std::size_t{ 16 };
+
+template <typename K>
+constexpr auto
+probe(K const* keys, std::size_t size, K const& key) noexcept -> std::size_t
+{
+  auto i = std::size_t{ 0 };
+  if constexpr (is_block_probed_v<K>) {
+    for (; i + block_width <= size; i += block_width) {
+      auto any = false;
+      for (auto j = std::size_t{ 0 }; j < block_width; ++j) {
+        any |= keys[i + j] == key;
+      }
+      if (any) {
+        break;
+      }
+    }
+  }
+  for (; i < size; ++i) {
+    if (keys[i] == key) {
+      return i;
+    }
+  }
+  return size;
+}
+
+} // namespace detail::lru
+
+// Fixed capacity least recently used cache. Keys and values live in parallel `inplace_vector`s
+// (dense, slots are reused in place on eviction) and recency is an intrusive doubly linked list of
+// `smallest_size_t<N>` indices. Lookup is a linear probe over the key array, which beats hashing for
+// the small N this is meant for.
+template <typename K, typename V, std::size_t N>
+  requires(N > 0 && std::equality_comparable<K>)
+class inplace_lru_cache
+{
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using size_type = std::size_t;
+  using link_type = detail::ipv::storage::smallest_size_t<N>;
+
+private:
+  static constexpr auto _npos = static_cast<link_type>(N);
+
+  inplace_vector<K, N> _keys;
+  inplace_vector<V, N> _values;
+  std::array<link_type, N> _prev{};
+  std::array<link_type, N> _next{};
+  link_type _head{ _npos }; // most recently used
+  link_type _tail{ _npos }; // least recently used
+  std::uint64_t _hits{ 0 };
+  std::uint64_t _misses{ 0 };
+
+  [[nodiscard]] constexpr auto
+  _find(K const& key) const noexcept -> size_type
+  {
+    return detail::lru::probe(_keys.data(), _keys.size(), key);
+  }
+
+  constexpr auto
+  _unlink(link_type i) noexcept -> void
+  {
+    auto const prev = _prev[i];
+    auto const next = _next[i];
+    (prev != _npos ? _next[prev] : _head) = next;
+    (next != _npos ? _prev[next] : _tail) = prev;
+  }
+
+  constexpr auto
+  _link_front(link_type i) noexcept -> void
+  {
+    _prev[i] = _npos;
+    _next[i] = _head;
+    (_head != _npos ? _prev[_head] : _tail) = i;
+    _head = i;
+  }
+
+  constexpr auto
+  _touch(link_type i) noexcept -> void
+  {
+    if (i != _head) {
+      _unlink(i);
+      _link_front(i);
+    }
+  }
+
+  // Takes the next unused slot, or reuses the least recently used one in place. The key is built
+  // before the value so that a throwing constructor leaves `_keys` and `_values` in step, and on
+  // eviction both are built before they are moved in, so that it leaves the evicted entry intact.
+  template <typename KK, typename... Args>
+  constexpr auto
+  _insert(KK&& key, Args&&... args) -> V&
+  {
+    if (_keys.size() < N) {
+      auto const i = static_cast<link_type>(_keys.size());
+      _keys.unchecked_emplace_back(std::forward<KK>(key));
+      try {
+        _values.unchecked_emplace_back(std::forward<Args>(args)...);
+      } catch (...) {
+        _keys.pop_back();
+        throw;
+      }
+      _link_front(i);
+      return _values[i];
+    }
+
+    auto const i = _tail;
+    auto k = K(std::forward<KK>(key));
+    auto v = V(std::forward<Args>(args)...);
+    _keys[i] = std::move(k);
+    _values[i] = std::move(v);
+    _touch(i);
+    return _values[i];
+  }
+
+public:
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _keys.size();
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return _keys.empty();
+  }
+
+  [[nodiscard]] constexpr auto
+  hits() const noexcept -> std::uint64_t
+  {
+    return _hits;
+  }
+
+  [[nodiscard]] constexpr auto
+  misses() const noexcept -> std::uint64_t
+  {
+    return _misses;
+  }
+
+  constexpr auto
+  reset_stats() noexcept -> void
+  {
+    _hits = 0;
+    _misses = 0;
+  }
+
+  // counted lookup that marks `key` most recently used, nullptr on miss
+  [[nodiscard]] constexpr auto
+  get(K const& key) noexcept -> V*
+  {
+    auto const i = _find(key);
+    if (i == size()) {
+      ++_misses;
+      return nullptr;
+    }
+    ++_hits;
+    _touch(static_cast<link_type>(i));
+    return _values.data() + i;
+  }
+
+  // uncounted lookup that leaves recency untouched
+  [[nodiscard]] constexpr auto
+  peek(K const& key) const noexcept -> V const*
+  {
+    auto const i = _find(key);
+    return i == size() ? nullptr : _values.data() + i;
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(K const& key) const noexcept -> bool
+  {
+    return _find(key) != size();
+  }
+
+  // inserts or assigns, evicting the least recently used entry when full
+  template <typename KK = K, typename VV = V>
+  constexpr auto
+  put(KK&& key, VV&& value) -> V&
+  {
+    auto const i = _find(key);
+    if (i != size()) {
+      _values[i] = std::forward<VV>(value);
+      _touch(static_cast<link_type>(i));
+      return _values[i];
+    }
+    return _insert(std::forward<KK>(key), std::forward<VV>(value));
+  }
+
+  // memoization entry point: counted lookup, calling `make()` to fill the entry on a miss
+  template <typename F>
+    requires(std::is_invocable_r_v<V, F&>)
+  constexpr auto
+  get_or_insert(K const& key, F&& make) -> V&
+  {
+    if (auto const value = get(key)) {
+      return *value;
+    }
+    return _insert(key, std::invoke(make));
+  }
+
+  constexpr auto
+  erase(K const& key) -> bool
+  {
+    auto const i = static_cast<link_type>(_find(key));
+    if (i == size()) {
+      return false;
+    }
+
+    _unlink(i);
+    auto const last = static_cast<link_type>(size() - 1);
+    if (i != last) {
+      _keys[i] = std::move(_keys[last]);
+      _values[i] = std::move(_values[last]);
+      _prev[i] = _prev[last];
+      _next[i] = _next[last];
+      (_prev[i] != _npos ? _next[_prev[i]] : _head) = i;
+      (_next[i] != _npos ? _prev[_next[i]] : _tail) = i;
+    }
+    _keys.pop_back();
+    _values.pop_back();
+    return true;
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    _keys.clear();
+    _values.clear();
+    _head = _npos;
+    _tail = _npos;
+  }
+
+  // visits entries from most to least recently used
+  template <typename F>
+  constexpr auto
+  for_each(F&& f) const -> void
+  {
+    for (auto i = _head; i != _npos; i = _next[i]) {
+      std::invoke(f, _keys[i], _values[i]);
+    }
+  }
+};
+
+} // namespace mtp
+
+#endif // MTP_INPLACE_LRU_CACHE_HPP
@@ -0,0 +1,268 @@
+#ifndef MTP_INPLACE_MEMORY_RESOURCE_HPP
+#define MTP_INPLACE_MEMORY_RESOURCE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace mtp {
+
+// Monotonic `std::pmr::memory_resource` over an inline buffer of `Bytes` bytes, the
+// `byte_storage` of allocators: allocation bumps an offset and deallocation is a no-op, except
+// for the most recent block, which is given back (coroutine frames and scoped containers tend to
+// be freed in reverse order). When the buffer is exhausted allocations go to `upstream`, whose
+// blocks are kept until `release` or destruction; without an upstream they throw
+// `std::bad_alloc`.
+//
+// Not thread-safe, like `std::pmr::monotonic_buffer_resource`.
+template <std::size_t Bytes, std::size_t Align = alignof(std::max_align_t)>
+  requires(Bytes > 0 && std::has_single_bit(Align))
+class inplace_memory_resource : public std::pmr::memory_resource
+{
+  // header of a block taken from upstream, linked for `release`
+  struct _block
+  {
+    _block* next;
+    std::size_t bytes;
+    std::size_t align;
+  };
+
+  alignas(Align) std::byte _buffer[Bytes];
+  std::size_t _used{ 0 };
+  std::pmr::memory_resource* _upstream{ nullptr };
+  _block* _blocks{ nullptr };
+  std::size_t _upstream_bytes{ 0 };
+
+  [[nodiscard]] static constexpr auto
+  _align_up(std::size_t offset, std::size_t align) noexcept -> std::size_t
+  {
+    return (offset + align - 1) & ~(align - 1);
+  }
+
+  [[nodiscard]] auto
+  _allocate_upstream(std::size_t bytes, std::size_t align) -> void*
+  {
+    auto const offset = _align_up(sizeof(_block), align);
+    auto const block_align = std::max(align, alignof(_block));
+    auto const base = _upstream->allocate(offset + bytes, block_align);
+    _blocks = ::new (base) _block{ _blocks, offset + bytes, block_align };
+    _upstream_bytes += bytes;
+    return static_cast<std::byte*>(base) + offset;
+  }
+
+protected:
+  auto
+  do_allocate(std::size_t bytes, std::size_t align) -> void* override
+  {
+    // the buffer address decides the padding, so alignments above Align still work; sizes are
+    // rounded to the alignment so that same-aligned blocks are contiguous and roll back in turn
+    auto const base = reinterpret_cast<std::uintptr_t>(_buffer);
+    auto const first = _align_up(base + _used, align) - base;
+    auto const padded = _align_up(bytes, align);
+    if (first <= Bytes && padded <= Bytes - first) {
+      _used = first + padded;
+      return _buffer + first;
+    }
+
+    if (_upstream == nullptr)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+        return nullptr;
+      }
+    return _allocate_upstream(bytes, align);
+  }
+
+  auto
+  do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override
+  {
+    // only the last buffer block can be reclaimed, anything else waits for `release`
+    if (owns(p) && static_cast<std::byte*>(p) + _align_up(bytes, align) == _buffer + _used) {
+      _used = static_cast<std::size_t>(static_cast<std::byte*>(p) - _buffer);
+    }
+  }
+
+  [[nodiscard]] auto
+  do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+  {
+    return this == &other;
+  }
+
+public:
+  inplace_memory_resource() noexcept = default;
+
+  // falls back to `upstream` when the buffer is exhausted
+  explicit inplace_memory_resource(std::pmr::memory_resource* upstream) noexcept
+      : _upstream(upstream)
+  {
+  }
+
+  inplace_memory_resource(inplace_memory_resource const&) = delete;
+  auto operator=(inplace_memory_resource const&) -> inplace_memory_resource& = delete;
+
+  ~inplace_memory_resource() override
+  {
+    release();
+  }
+
+  // Frees everything at once: the buffer is reused from the start and the upstream blocks are
+  // returned.
+  auto
+  release() noexcept -> void
+  {
+    while (_blocks != nullptr) {
+      auto const block = _blocks;
+      _blocks = block->next;
+      _upstream->deallocate(block, block->bytes, block->align);
+    }
+    _used = 0;
+    _upstream_bytes = 0;
+  }
+
+  [[nodiscard]] auto
+  upstream_resource() const noexcept -> std::pmr::memory_resource*
+  {
+    return _upstream;
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> std::size_t
+  {
+    return Bytes;
+  }
+
+  // buffer bytes handed out, alignment padding included
+  [[nodiscard]] auto
+  used() const noexcept -> std::size_t
+  {
+    return _used;
+  }
+
+  [[nodiscard]] auto
+  remaining() const noexcept -> std::size_t
+  {
+    return Bytes - _used;
+  }
+
+  // bytes requested from upstream since the last `release`, 0 while everything fits the buffer
+  [[nodiscard]] auto
+  upstream_bytes() const noexcept -> std::size_t
+  {
+    return _upstream_bytes;
+  }
+
+  [[nodiscard]] auto
+  owns(void const* p) const noexcept -> bool
+  {
+    auto const address = std::less_equal<>{};
+    return address(static_cast<void const*>(_buffer), p) &&
+           address(p, static_cast<void const*>(_buffer + Bytes));
+  }
+};
+
+// Base for coroutine promise types that take their frames from a `std::pmr::memory_resource`
+// (an `inplace_memory_resource` for allocation free coroutines). A coroutine whose parameters
+// start with `std::allocator_arg_t, R&`, after the object parameter for member coroutines, with R
+// derived from `std::pmr::memory_resource`, allocates its frame from that resource; other
+// coroutines use `std::pmr::new_delete_resource()`. The resource must outlive the frame, which is
+// preceded by a small header recording it for `operator delete`.
+class promise_frame_allocator
+{
+  struct _header
+  {
+    std::pmr::memory_resource* resource;
+    std::size_t bytes;
+  };
+
+  static constexpr auto _align = std::size_t{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+  static constexpr auto _prefix = (sizeof(_header) + _align - 1) & ~(_align - 1);
+
+  [[nodiscard]] static auto
+  _allocate(std::size_t size, std::pmr::memory_resource& resource) -> void*
+  {
+    auto const bytes = _prefix + size;
+    auto const base = static_cast<std::byte*>(resource.allocate(bytes, _align));
+    ::new (static_cast<void*>(base)) _header{ std::addressof(resource), bytes };
+    return base + _prefix;
+  }
+
+  static auto
+  _deallocate(void* frame) noexcept -> void
+  {
+    auto const base = static_cast<std::byte*>(frame) - _prefix;
+    auto const header = *std::launder(reinterpret_cast<_header*>(base));
+    header.resource->deallocate(base, header.bytes, _align);
+  }
+
+public:
+  template <std::derived_from<std::pmr::memory_resource> R, typename... Args>
+  [[nodiscard]] static auto
+  operator new(std::size_t size, std::allocator_arg_t, R& resource, Args const&...) -> void*
+  {
+    return _allocate(size, resource);
+  }
+
+  template <typename This, std::derived_from<std::pmr::memory_resource> R, typename... Args>
+  [[nodiscard]] static auto
+  operator new(std::size_t size, This const&, std::allocator_arg_t, R& resource, Args const&...)
+      -> void*
+  {
+    return _allocate(size, resource);
+  }
+
+  [[nodiscard]] static auto
+  operator new(std::size_t size) -> void*
+  {
+    return _allocate(size, *std::pmr::new_delete_resource());
+  }
+
+  static auto
+  operator delete(void* frame, std::size_t) noexcept -> void
+  {
+    _deallocate(frame);
+  }
+
+  // match the placement forms above, the header knows where the frame came from
+  template <std::derived_from<std::pmr::memory_resource> R, typename... Args>
+  static auto
+  operator delete(void* frame, std::allocator_arg_t, R&, Args const&...) noexcept -> void
+  {
+    _deallocate(frame);
+  }
+
+  template <typename This, std::derived_from<std::pmr::memory_resource> R, typename... Args>
+  static auto
+  operator delete(void* frame, This const&, std::allocator_arg_t, R&, Args const&...) noexcept
+      -> void
+  {
+    _deallocate(frame);
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_MEMORY_RESOURCE_HPP
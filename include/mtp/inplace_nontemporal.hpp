@@ -0,0 +1,166 @@
+#ifndef MTP_INPLACE_NONTEMPORAL_HPP
+#define MTP_INPLACE_NONTEMPORAL_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <immintrin.h>
+#endif
+
+namespace mtp {
+
+namespace detail::ipv::nontemporal {
+
+// ranges that can be copied into an `inplace_vector<T, N>` byte for byte
+template <typename R, typename T>
+concept streamable_range = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+                           std::same_as<std::ranges::range_value_t<R>, T> &&
+                           std::is_trivially_copyable_v<T>;
+
+// Copies `bytes` bytes with non-temporal stores, which write around the cache: for large buffers
+// that are written once and read elsewhere (by another core or a device), the copy does not evict
+// the writer's working set. Falls back to `std::memcpy` without SSE2. The ranges must not overlap.
+inline auto
+copy(void* dst, void const* src, std::size_t bytes) noexcept -> void
+{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  auto out = static_cast<std::byte*>(dst);
+  auto in = static_cast<std::byte const*>(src);
+
+  // streaming stores need 16 byte aligned destinations, the unaligned head goes through the cache
+  auto const head = std::min(bytes, (16 - reinterpret_cast<std::uintptr_t>(out) % 16) % 16);
+  std::memcpy(out, in, head);
+  out += head;
+  in += head;
+  bytes -= head;
+
+  // whole cache lines at a time, so that each write-combining buffer is flushed full
+  for (; bytes >= 64; out += 64, in += 64, bytes -= 64) {
+    auto const v0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+    auto const v1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + 16));
+    auto const v2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + 32));
+    auto const v3 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(out), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(out + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(out + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(out + 48), v3);
+  }
+  for (; bytes >= 16; out += 16, in += 16, bytes -= 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_loadu_si128(reinterpret_cast<__m128i const*>(in)));
+  }
+  std::memcpy(out, in, bytes);
+
+  // non-temporal stores are weakly ordered: make them visible before e.g. a release store that
+  // publishes the buffer
+  _mm_sfence();
+#else
+  std::memcpy(dst, src, bytes);
+#endif
+}
+
+// copies `count` elements to `pos` (uninitialized or trivially copyable elements), streaming past
+// the cache outside of constant evaluation
+template <typename T>
+constexpr auto
+copy_to(T* pos, T const* first, std::size_t count) noexcept -> void
+{
+  if (std::is_constant_evaluated()) {
+    using detail::ipv::memory::uninitialized_copy_n;
+    uninitialized_copy_n(first, count, pos);
+  }
+  else if (count > 0) {
+    copy(pos, first, count * sizeof(T));
+  }
+}
+
+} // namespace detail::ipv::nontemporal
+
+// selects the streaming overloads of `assign` and `append_range` below
+struct nontemporal_t
+{
+  explicit nontemporal_t() = default;
+};
+
+inline constexpr auto nontemporal = nontemporal_t{};
+
+// Like `ipv.assign_range(rg)` with non-temporal stores, for large buffers written once and read by
+// another core: the copy does not pull the destination into, or evict from, the writer's cache.
+template <typename T, std::size_t N, detail::ipv::nontemporal::streamable_range<T> R>
+constexpr auto
+assign_range(nontemporal_t, inplace_vector<T, N>& ipv, R&& rg) -> void
+{
+  auto const count = static_cast<std::size_t>(std::ranges::size(rg));
+  if (count > N)
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+      return;
+    }
+
+  detail::ipv::nontemporal::copy_to(ipv.data(), std::ranges::data(rg), count);
+  detail::ipv::access::set_size(ipv, count);
+}
+
+template <typename T, std::size_t N, std::contiguous_iterator I, std::sized_sentinel_for<I> S>
+  requires(std::same_as<std::iter_value_t<I>, T> && std::is_trivially_copyable_v<T>)
+constexpr auto
+assign(nontemporal_t, inplace_vector<T, N>& ipv, I first, S last) -> void
+{
+  auto const count = static_cast<std::size_t>(last - first);
+  if (count > N)
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+      return;
+    }
+
+  detail::ipv::nontemporal::copy_to(ipv.data(), std::to_address(first), count);
+  detail::ipv::access::set_size(ipv, count);
+}
+
+// see `assign_range(nontemporal_t, inplace_vector<T, N>&, R&&)`
+template <typename T, std::size_t N, detail::ipv::nontemporal::streamable_range<T> R>
+constexpr auto
+append_range(nontemporal_t, inplace_vector<T, N>& ipv, R&& rg) -> void
+{
+  auto const count = static_cast<std::size_t>(std::ranges::size(rg));
+  if (count > N - ipv.size())
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::bad_alloc());
+      return;
+    }
+
+  detail::ipv::nontemporal::copy_to(ipv.data() + ipv.size(), std::ranges::data(rg), count);
+  detail::ipv::access::set_size(ipv, ipv.size() + count);
+}
+
+} // namespace mtp
+
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_NONTEMPORAL_HPP
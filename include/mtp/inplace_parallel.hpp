@@ -0,0 +1,350 @@
+#ifndef MTP_INPLACE_PARALLEL_HPP
+#define MTP_INPLACE_PARALLEL_HPP
+
+#include <mtp/inplace_algorithm.hpp>
+#include <mtp/inplace_vector.hpp>
+#include <mtp/inplace_ws_deque.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mtp {
+
+namespace detail::ipv::parallel {
+
+using chunk_deque = inplace_ws_deque<std::uint32_t, 1024>;
+
+// a chunk's vectors should stay in L1d while its kernel runs
+inline constexpr auto l1_data_cache_size = std::size_t{ 32 * 1024 };
+
+// fewer chunks per thread leave nothing to steal when kernel costs vary
+inline constexpr auto min_chunks_per_thread = std::size_t{ 8 };
+
+// Items per chunk: about an L1d worth of items, fewer when that would leave threads without
+// enough chunks, more when the chunks would not fit the deques.
+constexpr auto
+grain_size(std::size_t count, std::size_t item_bytes, std::size_t threads) noexcept -> std::size_t
+{
+  auto grain = std::max<std::size_t>(1, l1_data_cache_size / std::max<std::size_t>(1, item_bytes));
+  grain = std::min(grain, std::max<std::size_t>(1, count / (threads * min_chunks_per_thread)));
+  auto const max_chunks = threads * chunk_deque::capacity();
+  return std::max(grain, (count + max_chunks - 1) / max_chunks);
+}
+
+template <typename V>
+inline constexpr bool is_inplace_vector_v = false;
+
+template <typename T, std::size_t N>
+inline constexpr bool is_inplace_vector_v<inplace_vector<T, N>> = true;
+
+template <typename R>
+concept batch_range =
+    std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+    is_inplace_vector_v<std::ranges::range_value_t<R>> &&
+    !std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>>;
+
+} // namespace detail::ipv::parallel
+
+// what one batch call did, for tuning grain sizes and spotting imbalance
+struct batch_stats
+{
+  std::chrono::nanoseconds elapsed{ 0 };
+  std::size_t items{ 0 };
+  std::size_t grain{ 0 }; // items per chunk
+  std::size_t chunks{ 0 };
+  std::size_t steals{ 0 }; // successful `steal_half` calls
+  unsigned threads{ 0 };
+};
+
+// Local thread pool for data parallel batches. The index space of a batch is cut into chunks of
+// `grain` items, each thread starts with a contiguous block of chunks in its own
+// `inplace_ws_deque` and idle threads steal half of a random victim's remaining chunks. The calling
+// thread works as thread 0 and `run` returns when every chunk is done; the first exception thrown
+// by the body is rethrown there (the remaining chunks are skipped).
+//
+// One batch runs at a time, concurrent `run` calls are serialized.
+class batch_pool
+{
+  using _deque = detail::ipv::parallel::chunk_deque;
+
+  struct _job
+  {
+    void* body{ nullptr };
+    void (*run)(void*, std::size_t, std::size_t){ nullptr };
+    std::size_t count{ 0 };
+    std::size_t grain{ 0 };
+    std::size_t chunks{ 0 };
+    std::atomic<std::size_t> remaining{ 0 };
+    std::atomic<std::size_t> steals{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+  };
+
+  unsigned _threads;
+  std::unique_ptr<_deque[]> _deques;
+  std::vector<std::thread> _workers;
+
+  std::mutex _submit;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  _job* _current{ nullptr };
+  std::uint64_t _generation{ 0 };
+  unsigned _busy{ 0 };
+  bool _stop{ false };
+
+  auto
+  _run_chunk(_job& job, std::uint32_t chunk) -> void
+  {
+    if (!job.failed.load(std::memory_order_relaxed)) {
+      auto const first = chunk * job.grain;
+      auto const last = std::min(first + job.grain, job.count);
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+      try {
+        job.run(job.body, first, last);
+      } catch (...) {
+        auto const lock = std::lock_guard(_mutex);
+        if (!job.failed.exchange(true)) {
+          job.error = std::current_exception();
+        }
+      }
+#else
+      job.run(job.body, first, last);
+#endif
+    }
+    job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  auto
+  _work(_job& job, unsigned self) -> void
+  {
+    // only the owner may push: this thread's block goes in reversed so that it pops in order
+    auto& own = _deques[self];
+    auto const first = job.chunks * self / _threads;
+    for (auto c = job.chunks * (self + 1) / _threads; c > first; --c) {
+      static_cast<void>(own.try_push(static_cast<std::uint32_t>(c - 1)));
+    }
+
+    auto seed = self * 2654435761u + 1;
+    auto stolen = std::array<std::uint32_t, 32>{};
+    while (job.remaining.load(std::memory_order_acquire) != 0) {
+      if (auto chunk = std::uint32_t{}; own.try_pop(chunk)) {
+        _run_chunk(job, chunk);
+        continue;
+      }
+
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      auto const victim = seed % _threads;
+      auto const n = victim == self ? 0 : _deques[victim].steal_half(stolen);
+      if (n == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      job.steals.fetch_add(1, std::memory_order_relaxed);
+      for (auto i = std::size_t{ 1 }; i < n; ++i) {
+        static_cast<void>(own.try_push(stolen[i]));
+      }
+      _run_chunk(job, stolen[0]);
+    }
+  }
+
+  auto
+  _worker(unsigned self) -> void
+  {
+    auto seen = std::uint64_t{ 0 };
+    for (;;) {
+      auto job = static_cast<_job*>(nullptr);
+      {
+        auto lock = std::unique_lock(_mutex);
+        _wake.wait(lock, [&] { return _stop || _generation != seen; });
+        if (_stop) {
+          return;
+        }
+        seen = _generation;
+        job = _current;
+      }
+      _work(*job, self);
+      auto const lock = std::lock_guard(_mutex);
+      if (--_busy == 0) {
+        _done.notify_one();
+      }
+    }
+  }
+
+public:
+  explicit batch_pool(unsigned threads = std::thread::hardware_concurrency())
+      : _threads(std::max(threads, 1u))
+      , _deques(std::make_unique<_deque[]>(_threads))
+  {
+    _workers.reserve(_threads - 1);
+    for (auto t = 1u; t < _threads; ++t) {
+      _workers.emplace_back([this, t] { _worker(t); });
+    }
+  }
+
+  batch_pool(batch_pool const&) = delete;
+  auto operator=(batch_pool const&) -> batch_pool& = delete;
+
+  ~batch_pool()
+  {
+    {
+      auto const lock = std::lock_guard(_mutex);
+      _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers) {
+      worker.join();
+    }
+  }
+
+  [[nodiscard]] auto
+  threads() const noexcept -> unsigned
+  {
+    return _threads;
+  }
+
+  // Calls `body(first, last)` for consecutive index ranges covering [0, count), at most `grain`
+  // indices each (raised when the chunks would not fit the deques). `body` runs concurrently on
+  // all threads.
+  template <typename F>
+    requires(std::is_invocable_v<F&, std::size_t, std::size_t>)
+  auto
+  run(std::size_t count, std::size_t grain, F&& body) -> batch_stats
+  {
+    auto const start = std::chrono::steady_clock::now();
+    auto stats = batch_stats{};
+    stats.items = count;
+    stats.threads = _threads;
+    if (count == 0) {
+      return stats;
+    }
+
+    auto const max_chunks = _threads * _deque::capacity();
+    grain = std::max({ grain, std::size_t{ 1 }, (count + max_chunks - 1) / max_chunks });
+
+    auto job = _job{};
+    // F may be const, the cast below restores it
+    job.body = const_cast<void*>(static_cast<void const*>(std::addressof(body)));
+    job.run = [](void* body, std::size_t first, std::size_t last) {
+      std::invoke(*static_cast<std::remove_reference_t<F>*>(body), first, last);
+    };
+    job.count = count;
+    job.grain = grain;
+    job.chunks = (count + grain - 1) / grain;
+    job.remaining.store(job.chunks, std::memory_order_relaxed);
+
+    auto const submit = std::lock_guard(_submit);
+    {
+      auto const lock = std::lock_guard(_mutex);
+      _current = &job;
+      _busy = _threads - 1;
+      ++_generation;
+    }
+    _wake.notify_all();
+    _work(job, 0);
+    {
+      auto lock = std::unique_lock(_mutex);
+      _done.wait(lock, [&] { return _busy == 0; });
+      _current = nullptr;
+    }
+
+    stats.elapsed = std::chrono::steady_clock::now() - start;
+    stats.grain = grain;
+    stats.chunks = job.chunks;
+    stats.steals = job.steals.load(std::memory_order_relaxed);
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+#endif
+    return stats;
+  }
+};
+
+// Applies `kernel` to every vector of `batches` on `pool`, with an L1d sized grain. The kernel is
+// shared by all threads.
+template <detail::ipv::parallel::batch_range R, typename Kernel>
+  requires(std::is_invocable_v<Kernel&, std::ranges::range_reference_t<R>>)
+auto
+for_each_batch(batch_pool& pool, R&& batches, Kernel kernel) -> batch_stats
+{
+  auto const first = std::ranges::begin(batches);
+  auto const count = static_cast<std::size_t>(std::ranges::size(batches));
+  auto const grain = detail::ipv::parallel::grain_size(
+      count, sizeof(std::ranges::range_value_t<R>), pool.threads());
+  return pool.run(count, grain, [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      std::invoke(kernel, first[static_cast<std::ranges::range_difference_t<R>>(i)]);
+    }
+  });
+}
+
+// `mtp::sort` on every vector
+template <detail::ipv::parallel::batch_range R>
+auto
+sort_each(batch_pool& pool, R&& batches) -> batch_stats
+{
+  return for_each_batch(pool, batches, [](auto& ipv) { mtp::sort(ipv); });
+}
+
+template <detail::ipv::parallel::batch_range R, typename Compare>
+auto
+sort_each(batch_pool& pool, R&& batches, Compare comp) -> batch_stats
+{
+  return for_each_batch(pool, batches, [&](auto& ipv) { mtp::sort(ipv, comp); });
+}
+
+// sorts every vector and removes its duplicates
+template <detail::ipv::parallel::batch_range R>
+auto
+dedupe_each(batch_pool& pool, R&& batches) -> batch_stats
+{
+  return for_each_batch(pool, batches, [](auto& ipv) {
+    mtp::sort(ipv);
+    ipv.erase(std::unique(ipv.begin(), ipv.end()), ipv.end());
+  });
+}
+
+// keeps the elements of every vector that satisfy `pred`, in order
+template <detail::ipv::parallel::batch_range R, typename Pred>
+auto
+filter_each(batch_pool& pool, R&& batches, Pred pred) -> batch_stats
+{
+  return for_each_batch(pool, batches, [&](auto& ipv) {
+    ipv.erase(std::remove_if(ipv.begin(), ipv.end(),
+                             [&](auto const& value) { return !std::invoke(pred, value); }),
+              ipv.end());
+  });
+}
+
+// replaces every element with `f(element)`
+template <detail::ipv::parallel::batch_range R, typename F>
+auto
+transform_each(batch_pool& pool, R&& batches, F f) -> batch_stats
+{
+  return for_each_batch(pool, batches, [&](auto& ipv) {
+    for (auto& value : ipv) {
+      value = std::invoke(f, value);
+    }
+  });
+}
+
+} // namespace mtp
+
+#endif // MTP_INPLACE_PARALLEL_HPP
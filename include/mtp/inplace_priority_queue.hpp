@@ -0,0 +1,294 @@
+#ifndef MTP_INPLACE_PRIORITY_QUEUE_HPP
+#define MTP_INPLACE_PRIORITY_QUEUE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+// Fixed capacity priority queue over a d-ary heap. Like `std::priority_queue`, `top()` is the
+// greatest element with respect to `Compare`. Wider heaps are shallower, trading extra compares
+// per level for fewer (cache missing) levels; 4 is usually the sweet spot for small N.
+template <typename T, std::size_t N, typename Compare = std::less<T>, std::size_t Arity = 4>
+  requires(Arity >= 2)
+class inplace_priority_queue
+{
+public:
+  using container_type = inplace_vector<T, N>;
+  using value_compare = Compare;
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = T const&;
+
+private:
+  container_type _c;
+  [[no_unique_address]] Compare _comp;
+
+  constexpr auto
+  _sift_up(size_type i) -> void
+  {
+    auto value = std::move(_c[i]);
+    while (i > 0) {
+      auto const parent = (i - 1) / Arity;
+      if (!_comp(_c[parent], value)) {
+        break;
+      }
+      _c[i] = std::move(_c[parent]);
+      i = parent;
+    }
+    _c[i] = std::move(value);
+  }
+
+  constexpr auto
+  _sift_down(size_type i) -> void
+  {
+    auto const n = _c.size();
+    auto value = std::move(_c[i]);
+    for (;;) {
+      auto const first = i * Arity + 1;
+      if (first >= n) {
+        break;
+      }
+
+      auto const last = std::min(first + Arity, n);
+      auto best = first;
+      for (auto child = first + 1; child < last; ++child) {
+        if (_comp(_c[best], _c[child])) {
+          best = child;
+        }
+      }
+
+      if (!_comp(value, _c[best])) {
+        break;
+      }
+      _c[i] = std::move(_c[best]);
+      i = best;
+    }
+    _c[i] = std::move(value);
+  }
+
+  constexpr auto
+  _make_heap() -> void
+  {
+    if (_c.size() < 2) {
+      return;
+    }
+    for (auto i = (_c.size() - 2) / Arity + 1; i > 0; --i) {
+      _sift_down(i - 1);
+    }
+  }
+
+public:
+  constexpr inplace_priority_queue() = default;
+
+  explicit constexpr inplace_priority_queue(Compare const& comp)
+      : _comp(comp)
+  {}
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr inplace_priority_queue(I first, S last, Compare const& comp = Compare())
+      : _comp(comp)
+  {
+    heapify(std::ranges::subrange(std::move(first), std::move(last)));
+  }
+
+  [[nodiscard]] constexpr auto
+  top() const -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return _c.front();
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return _c.empty();
+  }
+
+  [[nodiscard]] constexpr auto
+  full() const noexcept -> bool
+  {
+    return _c.size() == N;
+  }
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _c.size();
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  // heap ordered, not sorted
+  [[nodiscard]] constexpr auto
+  container() const noexcept -> container_type const&
+  {
+    return _c;
+  }
+
+  template <typename... Args>
+  constexpr auto
+  emplace(Args&&... args) -> void
+  {
+    _c.emplace_back(std::forward<Args>(args)...);
+    _sift_up(_c.size() - 1);
+  }
+
+  constexpr auto
+  push(value_type const& value) -> void
+  {
+    emplace(value);
+  }
+
+  constexpr auto
+  push(value_type&& value) -> void
+  {
+    emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  constexpr auto
+  try_emplace(Args&&... args) -> bool
+  {
+    if (!_c.try_emplace_back(std::forward<Args>(args)...))
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    _sift_up(_c.size() - 1);
+    return true;
+  }
+
+  constexpr auto
+  try_push(value_type const& value) -> bool
+  {
+    return try_emplace(value);
+  }
+
+  constexpr auto
+  try_push(value_type&& value) -> bool
+  {
+    return try_emplace(std::move(value));
+  }
+
+  // Pushes while there is room; once full, `value` replaces `top()` only if it compares less, so
+  // the queue keeps the N least elements seen (e.g. top-K smallest with `std::less`).
+  // Returns whether `value` was kept.
+  template <typename U = value_type>
+  constexpr auto
+  push_bounded(U&& value) -> bool
+  {
+    if (!full()) {
+      _c.unchecked_emplace_back(std::forward<U>(value));
+      _sift_up(_c.size() - 1);
+      return true;
+    }
+    if constexpr (N == 0) {
+      return false;
+    }
+    else {
+      if (!_comp(value, _c.front())) {
+        return false;
+      }
+      _c.front() = std::forward<U>(value);
+      _sift_down(0);
+      return true;
+    }
+  }
+
+  constexpr auto
+  pop() -> void
+  {
+    MTP_EXPECTS(!empty());
+    if (_c.size() > 1) {
+      _c.front() = std::move(_c.back());
+      _c.pop_back();
+      _sift_down(0);
+    }
+    else {
+      _c.pop_back();
+    }
+  }
+
+  // pops and returns the top element
+  constexpr auto
+  extract_top() -> value_type
+  {
+    MTP_EXPECTS(!empty());
+    auto value = std::move(_c.front());
+    pop();
+    return value;
+  }
+
+  // Bulk load: appends the range then restores the heap bottom-up in O(n) instead of O(n log n)
+  // individual pushes. If the append throws (overflow or a throwing copy), the elements appended
+  // so far are kept and the heap is restored before rethrowing.
+  template <detail::ipv::concepts::container_compatible_range<value_type> R>
+  constexpr auto
+  heapify(R&& rg) -> void
+  {
+    try {
+      _c.append_range(std::forward<R>(rg));
+    } catch (...) {
+      _make_heap();
+      throw;
+    }
+    _make_heap();
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    _c.clear();
+  }
+
+  constexpr auto
+  swap(inplace_priority_queue& other) noexcept(std::is_nothrow_swappable_v<container_type> &&
+                                               std::is_nothrow_swappable_v<Compare>) -> void
+  {
+    using std::swap;
+    swap(_c, other._c);
+    swap(_comp, other._comp);
+  }
+
+  friend constexpr auto
+  swap(inplace_priority_queue& a, inplace_priority_queue& b) noexcept(noexcept(a.swap(b))) -> void
+  {
+    a.swap(b);
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_PRIORITY_QUEUE_HPP
@@ -0,0 +1,307 @@
+#ifndef MTP_INPLACE_RANGES_HPP
+#define MTP_INPLACE_RANGES_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+namespace detail::ipv::ranges {
+
+template <typename V>
+inline constexpr bool is_owning_view_v = false;
+
+template <typename R>
+inline constexpr bool is_owning_view_v<std::ranges::owning_view<R>> = true;
+
+// Elements are moved out of single pass sources, which never yield them again, and out of
+// containers passed as rvalues; anything else is copied.
+template <typename V>
+inline constexpr bool moves_elements_v = !std::ranges::forward_range<V> || is_owning_view_v<V>;
+
+// Appends elements of [first, last) to `out` until it is full and returns the first element not
+// taken. With a random access source that is one bounds check and a `try_append_range` of the
+// prefix that fits, a `memcpy` for contiguous trivially copyable elements.
+template <typename V, typename T, std::size_t N>
+constexpr auto
+fill(inplace_vector<T, N>& out, std::ranges::iterator_t<V> first, std::ranges::sentinel_t<V> last)
+    -> std::ranges::iterator_t<V>
+{
+  if constexpr (std::random_access_iterator<std::ranges::iterator_t<V>> &&
+                std::sized_sentinel_for<std::ranges::sentinel_t<V>, std::ranges::iterator_t<V>>) {
+    auto const count =
+        static_cast<std::iter_difference_t<std::ranges::iterator_t<V>>>(std::min<std::size_t>(
+            N - out.size(), static_cast<std::size_t>(std::ranges::distance(first, last))));
+    // copying a trivially copyable element is moving it, and keeps the contiguous fast path
+    if constexpr (moves_elements_v<V> && !std::is_trivially_copyable_v<T>) {
+      static_cast<void>(out.try_append_range(std::ranges::subrange(
+          std::make_move_iterator(first), std::make_move_iterator(first + count))));
+    }
+    else {
+      static_cast<void>(out.try_append_range(std::ranges::subrange(first, first + count)));
+    }
+    return first + count;
+  }
+  else {
+    for (; first != last && out.size() < N; ++first) {
+      if constexpr (moves_elements_v<V>) {
+        out.unchecked_emplace_back(std::ranges::iter_move(first));
+      }
+      else {
+        out.unchecked_emplace_back(*first);
+      }
+    }
+    return first;
+  }
+}
+
+template <std::size_t N>
+struct batched_fn;
+
+template <std::size_t N, overflow Policy>
+struct to_inplace_fn;
+
+} // namespace detail::ipv::ranges
+
+// Splits V into consecutive `inplace_vector<range_value_t<V>, N>` batches, the last one possibly
+// shorter. The view holds one batch and refills it on increment, so iterating never allocates and
+// works with unbounded single pass sources; dereferencing yields the batch itself, which may be
+// modified or moved from. An input view: `begin` may be called once.
+template <std::ranges::input_range V, std::size_t N>
+  requires(std::ranges::view<V> && N > 0)
+class batched_view : public std::ranges::view_interface<batched_view<V, N>>
+{
+public:
+  using batch_type = inplace_vector<std::ranges::range_value_t<V>, N>;
+
+private:
+  V _base;
+  std::optional<std::ranges::iterator_t<V>> _current;
+  batch_type _batch;
+
+  constexpr auto
+  _next() -> void
+  {
+    _batch.clear();
+    _current = detail::ipv::ranges::fill<V>(_batch, std::move(*_current), std::ranges::end(_base));
+  }
+
+public:
+  class iterator
+  {
+    batched_view* _parent{ nullptr };
+
+    friend class batched_view;
+
+    constexpr explicit iterator(batched_view& parent) noexcept
+        : _parent(std::addressof(parent))
+    {
+    }
+
+    [[nodiscard]] constexpr auto
+    _at_end() const noexcept -> bool
+    {
+      return _parent->_batch.empty();
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = batch_type;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+
+    [[nodiscard]] constexpr auto
+    operator*() const noexcept -> batch_type&
+    {
+      return _parent->_batch;
+    }
+
+    constexpr auto
+    operator++() -> iterator&
+    {
+      MTP_EXPECTS(!_parent->_batch.empty());
+      _parent->_next();
+      return *this;
+    }
+
+    constexpr auto
+    operator++(int) -> void
+    {
+      ++*this;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(iterator const& it, std::default_sentinel_t) noexcept -> bool
+    {
+      return it._at_end();
+    }
+  };
+
+  batched_view()
+    requires std::default_initializable<V>
+  = default;
+
+  constexpr explicit batched_view(V base)
+      : _base(std::move(base))
+  {
+  }
+
+  [[nodiscard]] constexpr auto
+  base() const& -> V
+    requires std::copy_constructible<V>
+  {
+    return _base;
+  }
+
+  [[nodiscard]] constexpr auto
+  base() && -> V
+  {
+    return std::move(_base);
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() -> iterator
+  {
+    _current = std::ranges::begin(_base);
+    _next();
+    return iterator(*this);
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> std::default_sentinel_t
+  {
+    return std::default_sentinel;
+  }
+};
+
+// Builds an `inplace_vector<range_value_t<R>, N>` from `rg`, taking elements the way
+// `views::batched` does. Elements past N are handled according to `Policy`.
+template <std::size_t N, overflow Policy = overflow::throw_exception, std::ranges::input_range R>
+  requires(std::ranges::viewable_range<R>)
+[[nodiscard]] constexpr auto
+to_inplace(R&& rg) -> inplace_vector<std::ranges::range_value_t<R>, N>
+{
+  using view = std::views::all_t<R>;
+  inplace_vector<std::ranges::range_value_t<R>, N> out;
+
+  auto&& source = std::views::all(std::forward<R>(rg));
+  if constexpr (std::ranges::sized_range<view>) {
+    if constexpr (Policy == overflow::throw_exception) {
+      if (std::ranges::size(source) > N)
+        MTP_UNLIKELY
+        {
+          MTP_THROW(std::bad_alloc());
+        }
+    }
+    else if constexpr (Policy == overflow::unchecked) {
+      MTP_EXPECTS(std::ranges::size(source) <= N);
+    }
+  }
+
+  auto const last = std::ranges::end(source);
+  [[maybe_unused]] auto const rest =
+      detail::ipv::ranges::fill<view>(out, std::ranges::begin(source), last);
+  if constexpr (Policy == overflow::throw_exception && !std::ranges::sized_range<view>) {
+    if (rest != last)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+  }
+  else if constexpr (Policy == overflow::unchecked) {
+    MTP_EXPECTS(rest == last);
+  }
+  return out;
+}
+
+// `rg | to_inplace<N>()`
+template <std::size_t N, overflow Policy = overflow::throw_exception>
+[[nodiscard]] constexpr auto
+to_inplace() noexcept -> detail::ipv::ranges::to_inplace_fn<N, Policy>
+{
+  return {};
+}
+
+namespace detail::ipv::ranges {
+
+template <std::size_t N>
+struct batched_fn
+{
+  template <std::ranges::viewable_range R>
+    requires(std::ranges::input_range<R>)
+  [[nodiscard]] constexpr auto
+  operator()(R&& rg) const -> batched_view<std::views::all_t<R>, N>
+  {
+    return batched_view<std::views::all_t<R>, N>(std::views::all(std::forward<R>(rg)));
+  }
+
+  template <std::ranges::viewable_range R>
+    requires(std::ranges::input_range<R>)
+  [[nodiscard]] friend constexpr auto
+  operator|(R&& rg, batched_fn const& fn) -> batched_view<std::views::all_t<R>, N>
+  {
+    return fn(std::forward<R>(rg));
+  }
+};
+
+template <std::size_t N, overflow Policy>
+struct to_inplace_fn
+{
+  template <std::ranges::input_range R>
+    requires(std::ranges::viewable_range<R>)
+  [[nodiscard]] friend constexpr auto
+  operator|(R&& rg, to_inplace_fn) -> inplace_vector<std::ranges::range_value_t<R>, N>
+  {
+    return to_inplace<N, Policy>(std::forward<R>(rg));
+  }
+};
+
+} // namespace detail::ipv::ranges
+
+namespace views {
+
+// `rg | views::batched<N>` or `views::batched<N>(rg)`
+template <std::size_t N>
+inline constexpr detail::ipv::ranges::batched_fn<N> batched{};
+
+} // namespace views
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_RANGES_HPP
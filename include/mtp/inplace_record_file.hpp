@@ -0,0 +1,611 @@
+#ifndef MTP_INPLACE_RECORD_FILE_HPP
+#define MTP_INPLACE_RECORD_FILE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#if !__has_include(<sys/mman.h>)
+#  error "mtp/inplace_record_file.hpp requires POSIX mmap"
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  include <stdexcept>
+#  include <system_error>
+#endif
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File of fixed width records, each one the object representation of an `inplace_vector<T, N>`
+// of trivially copyable T, behind a 64 byte header. Readers map the file and hand out the records
+// in place, so opening a warm-start cache costs a page fault per touched page rather than a parse.
+//
+// The header carries fingerprints of the element type name and of the record layout; files are
+// meant to be read back by the same build on the same platform and anything else is rejected.
+// Record counts are not stored: a file holds as many records as fit after the header, a partial
+// trailing record (an interrupted append) is ignored by readers and cut off by appending writers.
+
+namespace mtp {
+
+namespace detail::ipv::record_file {
+
+inline constexpr auto magic = std::array<char, 8>{ 'm', 't', 'p', 'i', 'p', 'v', 'r', 'f' };
+inline constexpr auto version = std::uint32_t{ 1 };
+
+consteval auto
+fnv1a(std::string_view bytes, std::uint64_t hash = 0xcbf29ce484222325) -> std::uint64_t
+{
+  for (auto const c : bytes) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+  }
+  return hash;
+}
+
+template <typename T>
+consteval auto
+type_name() -> std::string_view
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+template <typename T, std::size_t N>
+consteval auto
+layout_fingerprint() -> std::uint64_t
+{
+  using record = inplace_vector<T, N>;
+  auto hash = fnv1a("layout");
+  for (auto const value :
+       { sizeof(record), alignof(record), sizeof(T), alignof(T), N,
+         sizeof(typename record::size_type), static_cast<std::size_t>(std::endian::native) }) {
+    for (auto i = std::size_t{ 0 }; i < sizeof(value); ++i) {
+      hash = (hash ^ ((value >> (i * 8)) & 0xff)) * 0x100000001b3;
+    }
+  }
+  return hash;
+}
+
+struct header
+{
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t records_offset;
+  std::uint64_t type_fingerprint;
+  std::uint64_t layout_fingerprint;
+  std::uint64_t capacity;
+  std::uint64_t record_size;
+  std::uint64_t reserved[2];
+};
+static_assert(sizeof(header) == 64);
+
+template <typename T, std::size_t N>
+constexpr auto
+make_header() noexcept -> header
+{
+  constexpr auto records_offset = std::max(sizeof(header), alignof(inplace_vector<T, N>));
+  return header{ magic,
+                 version,
+                 static_cast<std::uint32_t>(records_offset),
+                 fnv1a(type_name<T>()),
+                 layout_fingerprint<T, N>(),
+                 N,
+                 sizeof(inplace_vector<T, N>),
+                 {} };
+}
+
+template <typename T, std::size_t N>
+auto
+matches(header const& h) noexcept -> bool
+{
+  constexpr auto expected = make_header<T, N>();
+  return h.magic == expected.magic && h.version == expected.version &&
+         h.records_offset == expected.records_offset &&
+         h.type_fingerprint == expected.type_fingerprint &&
+         h.layout_fingerprint == expected.layout_fingerprint && h.capacity == expected.capacity &&
+         h.record_size == expected.record_size;
+}
+
+inline auto
+write_all(int fd, std::byte const* data, std::size_t size) noexcept -> bool
+{
+  while (size > 0) {
+    auto const written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+inline auto
+read_all(int fd, std::byte* data, std::size_t size, off_t offset) noexcept -> bool
+{
+  while (size > 0) {
+    auto const got = ::pread(fd, data, size, offset);
+    if (got <= 0) {
+      if (got < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += got;
+    size -= static_cast<std::size_t>(got);
+    offset += got;
+  }
+  return true;
+}
+
+template <typename T, std::size_t N>
+concept recordable =
+    N > 0 && std::is_trivially_copyable_v<inplace_vector<T, N>> && !std::is_pointer_v<T>;
+
+} // namespace detail::ipv::record_file
+
+enum class record_file_mode
+{
+  truncate,
+  append,
+};
+
+// Streams records to a file through a write buffer. In append mode an existing file is validated
+// against the record type first and new records go after the last complete one. Elements past
+// each record's size are zeroed rather than written out as whatever the buffer held.
+//
+// Errors throw `std::system_error` (I/O) or `std::runtime_error` (mismatching file), or leave the
+// writer closed when exceptions are disabled.
+template <typename T, std::size_t N>
+  requires(detail::ipv::record_file::recordable<T, N>)
+class record_file_writer
+{
+public:
+  using record_type = inplace_vector<T, N>;
+  using size_type = std::size_t;
+
+private:
+  static constexpr auto _header = detail::ipv::record_file::make_header<T, N>();
+  static constexpr auto _buffered_records =
+      std::max(std::size_t{ 1 }, std::size_t{ 64 * 1024 } / sizeof(record_type));
+
+  int _fd{ -1 };
+  size_type _count{ 0 };
+  size_type _buffered{ 0 };
+  std::unique_ptr<std::byte[]> _buffer;
+
+  auto
+  _fail_io([[maybe_unused]] char const* what) -> void
+  {
+    [[maybe_unused]] auto const error = errno;
+    close();
+    MTP_THROW(std::system_error(error, std::generic_category(), what));
+  }
+
+  auto
+  _open(char const* path, record_file_mode mode) -> void
+  {
+    namespace rf = detail::ipv::record_file;
+
+    auto const flags =
+        O_RDWR | O_CREAT | O_CLOEXEC | (mode == record_file_mode::truncate ? O_TRUNC : 0);
+    _fd = ::open(path, flags, 0644);
+    if (_fd < 0)
+      MTP_UNLIKELY
+      {
+        _fail_io("mtp::record_file_writer: open");
+        return;
+      }
+
+    struct stat st{};
+    if (::fstat(_fd, &st) != 0)
+      MTP_UNLIKELY
+      {
+        _fail_io("mtp::record_file_writer: fstat");
+        return;
+      }
+
+    auto const file_size = static_cast<size_type>(st.st_size);
+    if (file_size == 0) {
+      // pad the header out to the first record
+      std::byte head[_header.records_offset]{};
+      std::memcpy(head, &_header, sizeof(_header));
+      if (!rf::write_all(_fd, head, sizeof(head)))
+        MTP_UNLIKELY
+        {
+          _fail_io("mtp::record_file_writer: write");
+          return;
+        }
+      return;
+    }
+
+    auto existing = rf::header{};
+    if (file_size < _header.records_offset ||
+        !rf::read_all(_fd, reinterpret_cast<std::byte*>(&existing), sizeof(existing), 0) ||
+        !rf::matches<T, N>(existing))
+      MTP_UNLIKELY
+      {
+        close();
+        MTP_THROW(std::runtime_error("mtp::record_file_writer: file does not hold these records"));
+        return;
+      }
+
+    _count = (file_size - _header.records_offset) / sizeof(record_type);
+    auto const end = static_cast<off_t>(_header.records_offset + _count * sizeof(record_type));
+    if (::ftruncate(_fd, end) != 0 || ::lseek(_fd, end, SEEK_SET) != end)
+      MTP_UNLIKELY
+      {
+        _fail_io("mtp::record_file_writer: seek");
+        return;
+      }
+  }
+
+public:
+  record_file_writer() noexcept = default;
+
+  explicit record_file_writer(char const* path, record_file_mode mode = record_file_mode::truncate)
+      : _buffer(
+            std::make_unique_for_overwrite<std::byte[]>(_buffered_records * sizeof(record_type)))
+  {
+    _open(path, mode);
+  }
+
+  record_file_writer(record_file_writer&& other) noexcept
+      : _fd(std::exchange(other._fd, -1))
+      , _count(std::exchange(other._count, 0))
+      , _buffered(std::exchange(other._buffered, 0))
+      , _buffer(std::move(other._buffer))
+  {}
+
+  auto
+  operator=(record_file_writer&& other) noexcept -> record_file_writer&
+  {
+    if (this != std::addressof(other)) {
+      static_cast<void>(try_close());
+      _fd = std::exchange(other._fd, -1);
+      _count = std::exchange(other._count, 0);
+      _buffered = std::exchange(other._buffered, 0);
+      _buffer = std::move(other._buffer);
+    }
+    return *this;
+  }
+
+  // flushes, use `close()` to see errors
+  ~record_file_writer()
+  {
+    static_cast<void>(try_close());
+  }
+
+  [[nodiscard]] auto
+  is_open() const noexcept -> bool
+  {
+    return _fd >= 0;
+  }
+
+  [[nodiscard]] explicit
+  operator bool() const noexcept
+  {
+    return is_open();
+  }
+
+  // records in the file, including buffered ones
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return _count;
+  }
+
+  auto
+  append(record_type const& record) -> void
+  {
+    MTP_EXPECTS(is_open());
+    if (_buffered == _buffered_records) {
+      flush();
+    }
+
+    // only the elements and the size are copied over a zeroed slot, so that neither the unused
+    // elements nor the padding leak memory contents into the file
+    auto const slot = _buffer.get() + _buffered * sizeof(record_type);
+    auto const base = reinterpret_cast<std::byte const*>(std::addressof(record));
+    auto const elements = reinterpret_cast<std::byte const*>(record.data());
+    auto const size_field = detail::ipv::access::size_data(record);
+    auto const size = reinterpret_cast<std::byte const*>(size_field);
+    std::memset(slot, 0, sizeof(record_type));
+    std::memcpy(slot + (elements - base), elements, record.size() * sizeof(T));
+    std::memcpy(slot + (size - base), size, sizeof(*size_field));
+    ++_buffered;
+    ++_count;
+  }
+
+  auto
+  append(std::span<record_type const> records) -> void
+  {
+    for (auto const& record : records) {
+      append(record);
+    }
+  }
+
+  // hands buffered records to the OS
+  [[nodiscard]] auto
+  try_flush() noexcept -> bool
+  {
+    if (_buffered == 0) {
+      return true;
+    }
+    auto const ok = detail::ipv::record_file::write_all(_fd, _buffer.get(),
+                                                        _buffered * sizeof(record_type));
+    _buffered = 0;
+    return ok;
+  }
+
+  auto
+  flush() -> void
+  {
+    if (!try_flush())
+      MTP_UNLIKELY
+      {
+        _fail_io("mtp::record_file_writer: write");
+      }
+  }
+
+  // flushes buffered records and makes the file durable
+  auto
+  sync() -> void
+  {
+    flush();
+    if (::fsync(_fd) != 0)
+      MTP_UNLIKELY
+      {
+        _fail_io("mtp::record_file_writer: fsync");
+      }
+  }
+
+  [[nodiscard]] auto
+  try_close() noexcept -> bool
+  {
+    if (_fd < 0) {
+      return true;
+    }
+    auto const flushed = try_flush();
+    auto const closed = ::close(std::exchange(_fd, -1)) == 0;
+    return flushed && closed;
+  }
+
+  auto
+  close() noexcept -> void
+  {
+    static_cast<void>(try_close());
+  }
+};
+
+// Maps a record file read only and exposes its records in place. Opening validates the header and
+// every record's size field against N, after that access is plain memory reads.
+//
+// Errors throw `std::system_error` (I/O) or `std::runtime_error` (mismatching or corrupt file),
+// or leave the reader closed when exceptions are disabled.
+template <typename T, std::size_t N>
+  requires(detail::ipv::record_file::recordable<T, N>)
+class record_file_reader
+{
+public:
+  using record_type = inplace_vector<T, N>;
+  using size_type = std::size_t;
+  using const_iterator = record_type const*;
+
+private:
+  static constexpr auto _header = detail::ipv::record_file::make_header<T, N>();
+
+  void* _map{ nullptr };
+  size_type _map_size{ 0 };
+  std::span<record_type const> _records;
+
+  auto
+  _fail(int fd, [[maybe_unused]] int error, [[maybe_unused]] char const* what) -> void
+  {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    close();
+    if (error != 0) {
+      MTP_THROW(std::system_error(error, std::generic_category(), what));
+    }
+    else {
+      MTP_THROW(std::runtime_error(what));
+    }
+  }
+
+public:
+  record_file_reader() noexcept = default;
+
+  explicit record_file_reader(char const* path)
+  {
+    namespace rf = detail::ipv::record_file;
+
+    auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      MTP_UNLIKELY
+      {
+        _fail(fd, errno, "mtp::record_file_reader: open");
+        return;
+      }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+      MTP_UNLIKELY
+      {
+        _fail(fd, errno, "mtp::record_file_reader: fstat");
+        return;
+      }
+    _map_size = static_cast<size_type>(st.st_size);
+    if (_map_size < _header.records_offset)
+      MTP_UNLIKELY
+      {
+        _fail(fd, 0, "mtp::record_file_reader: file does not hold these records");
+        return;
+      }
+
+    auto const map = ::mmap(nullptr, _map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto const error = errno;
+    ::close(fd);
+    if (map == MAP_FAILED)
+      MTP_UNLIKELY
+      {
+        _fail(-1, error, "mtp::record_file_reader: mmap");
+        return;
+      }
+    _map = map;
+
+    auto const bytes = static_cast<std::byte const*>(_map);
+    auto existing = rf::header{};
+    std::memcpy(&existing, bytes, sizeof(existing));
+    if (!rf::matches<T, N>(existing))
+      MTP_UNLIKELY
+      {
+        _fail(-1, 0, "mtp::record_file_reader: file does not hold these records");
+        return;
+      }
+
+    // mmap is page aligned and the first record sits at a multiple of its alignment
+    auto const count = (_map_size - _header.records_offset) / sizeof(record_type);
+    auto const first = reinterpret_cast<record_type const*>(bytes + _header.records_offset);
+    auto const corrupt =
+        std::any_of(first, first + count, [](record_type const& r) { return r.size() > N; });
+    if (corrupt)
+      MTP_UNLIKELY
+      {
+        _fail(-1, 0, "mtp::record_file_reader: record size exceeds capacity");
+        return;
+      }
+    _records = std::span(first, count);
+  }
+
+  record_file_reader(record_file_reader&& other) noexcept
+      : _map(std::exchange(other._map, nullptr))
+      , _map_size(std::exchange(other._map_size, 0))
+      , _records(std::exchange(other._records, {}))
+  {}
+
+  auto
+  operator=(record_file_reader&& other) noexcept -> record_file_reader&
+  {
+    if (this != std::addressof(other)) {
+      close();
+      _map = std::exchange(other._map, nullptr);
+      _map_size = std::exchange(other._map_size, 0);
+      _records = std::exchange(other._records, {});
+    }
+    return *this;
+  }
+
+  ~record_file_reader()
+  {
+    close();
+  }
+
+  auto
+  close() noexcept -> void
+  {
+    if (_map) {
+      ::munmap(_map, _map_size);
+    }
+    _map = nullptr;
+    _map_size = 0;
+    _records = {};
+  }
+
+  [[nodiscard]] auto
+  is_open() const noexcept -> bool
+  {
+    return _map != nullptr;
+  }
+
+  [[nodiscard]] explicit
+  operator bool() const noexcept
+  {
+    return is_open();
+  }
+
+  [[nodiscard]] auto
+  records() const noexcept -> std::span<record_type const>
+  {
+    return _records;
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return _records.size();
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return _records.empty();
+  }
+
+  [[nodiscard]] auto
+  operator[](size_type pos) const noexcept -> record_type const&
+  {
+    return _records[pos];
+  }
+
+  [[nodiscard]] auto
+  begin() const noexcept -> const_iterator
+  {
+    return _records.data();
+  }
+
+  [[nodiscard]] auto
+  end() const noexcept -> const_iterator
+  {
+    return _records.data() + _records.size();
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_RECORD_FILE_HPP
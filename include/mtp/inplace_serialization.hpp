@@ -0,0 +1,324 @@
+#ifndef MTP_INPLACE_SERIALIZATION_HPP
+#define MTP_INPLACE_SERIALIZATION_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  include <stdexcept>
+#endif
+#include <type_traits>
+
+#if __has_include(<sys/uio.h>)
+#  include <sys/uio.h>
+#endif
+
+// Wire format of an `inplace_vector<T, N>` of trivially copyable T: the size as a native endian
+// `std::uint64_t`, zero padding up to `alignof(T)`, then `size()` elements exactly as they are
+// laid out in `data()`. The format does not depend on N, any capacity can read what another one
+// wrote as long as the size fits. Byte order and representation are the host's, so this is meant
+// for peers of the same platform (IPC, local files), not as a portable interchange format.
+
+namespace mtp {
+
+namespace detail::ipv::serialization {
+
+template <typename T>
+concept wire_type = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+template <typename T>
+inline constexpr auto header_size = std::max(sizeof(std::uint64_t), alignof(T));
+
+// size of the record at the front of `bytes`, or 0 (never a valid record size) when `bytes` does
+// not start with a complete record of at most N elements
+template <typename T, std::size_t N>
+constexpr auto
+record_size(std::span<std::byte const> bytes) noexcept -> std::size_t
+{
+  if (bytes.size() < header_size<T>)
+    MTP_UNLIKELY
+    {
+      return 0;
+    }
+  auto size = std::uint64_t{ 0 };
+  std::memcpy(&size, bytes.data(), sizeof(size));
+  if (size > N || (bytes.size() - header_size<T>) / sizeof(T) < size)
+    MTP_UNLIKELY
+    {
+      return 0;
+    }
+  return header_size<T> + static_cast<std::size_t>(size) * sizeof(T);
+}
+
+} // namespace detail::ipv::serialization
+
+// The size prefix (and padding) of a record, kept by the caller while its bytes are written next
+// to the payload that stays in the vector.
+template <detail::ipv::serialization::wire_type T>
+class serialized_header
+{
+  alignas(std::uint64_t) std::byte _bytes[detail::ipv::serialization::header_size<T>]{};
+
+public:
+  explicit serialized_header(std::size_t size) noexcept
+  {
+    auto const wire_size = static_cast<std::uint64_t>(size);
+    std::memcpy(_bytes, &wire_size, sizeof(wire_size));
+  }
+
+  [[nodiscard]] auto
+  bytes() const noexcept -> std::span<std::byte const, detail::ipv::serialization::header_size<T>>
+  {
+    return std::span(_bytes);
+  }
+};
+
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+[[nodiscard]] auto
+serialized_size(inplace_vector<T, N> const& ipv) noexcept -> std::size_t
+{
+  return detail::ipv::serialization::header_size<T> + ipv.size() * sizeof(T);
+}
+
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+[[nodiscard]] auto
+serialize_header(inplace_vector<T, N> const& ipv) noexcept -> serialized_header<T>
+{
+  return serialized_header<T>(ipv.size());
+}
+
+// the elements as bytes, straight out of the vector
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+[[nodiscard]] auto
+payload_bytes(inplace_vector<T, N> const& ipv) noexcept -> std::span<std::byte const>
+{
+  return std::as_bytes(std::span(ipv.data(), ipv.size()));
+}
+
+#if __has_include(<sys/uio.h>)
+// Scatter list for `writev`: the header, then the payload in place. `header` must outlive the
+// write.
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+[[nodiscard]] auto
+to_iovecs(serialized_header<T> const& header, inplace_vector<T, N> const& ipv) noexcept
+    -> std::array<iovec, 2>
+{
+  auto const payload = payload_bytes(ipv);
+  return { iovec{ const_cast<std::byte*>(header.bytes().data()), header.bytes().size() },
+           iovec{ const_cast<std::byte*>(payload.data()), payload.size() } };
+}
+#endif
+
+// Writes one record at the front of `out`. Returns the end of the written bytes, or nullptr when
+// `out` is too small.
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+auto
+try_serialize(inplace_vector<T, N> const& ipv, std::span<std::byte> out) noexcept -> std::byte*
+{
+  if (out.size() < serialized_size(ipv))
+    MTP_UNLIKELY
+    {
+      return nullptr;
+    }
+  auto const header = serialize_header(ipv);
+  auto const payload = payload_bytes(ipv);
+  std::memcpy(out.data(), header.bytes().data(), header.bytes().size());
+  if (!payload.empty()) {
+    std::memcpy(out.data() + header.bytes().size(), payload.data(), payload.size());
+  }
+  return out.data() + header.bytes().size() + payload.size();
+}
+
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+auto
+serialize(inplace_vector<T, N> const& ipv, std::span<std::byte> out) -> std::byte*
+{
+  auto const end = try_serialize(ipv, out);
+  if (!end)
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::length_error("mtp::serialize"));
+    }
+  return end;
+}
+
+// Zero-copy read access to a record inside a received buffer. Construction validates the size
+// prefix against N and the buffer length, and requires the payload to be aligned for T (records
+// written at `alignof(T)` multiples of an aligned buffer are); an invalid view converts to false.
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+class serialized_view
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_iterator = T const*;
+
+private:
+  T const* _data{ nullptr };
+  size_type _size{ 0 };
+
+public:
+  constexpr serialized_view() noexcept = default;
+
+  explicit serialized_view(std::span<std::byte const> bytes) noexcept
+  {
+    namespace s = detail::ipv::serialization;
+    auto const record = s::record_size<T, N>(bytes);
+    if (record == 0)
+      MTP_UNLIKELY
+      {
+        return;
+      }
+    auto const payload = bytes.data() + s::header_size<T>;
+    if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0)
+      MTP_UNLIKELY
+      {
+        return;
+      }
+    _data = reinterpret_cast<T const*>(payload);
+    _size = (record - s::header_size<T>) / sizeof(T);
+  }
+
+  [[nodiscard]] explicit
+  operator bool() const noexcept
+  {
+    return _data != nullptr;
+  }
+
+  [[nodiscard]] auto
+  data() const noexcept -> T const*
+  {
+    return _data;
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return _size;
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return _size == 0;
+  }
+
+  // bytes taken by the record, to step to the next one in a stream
+  [[nodiscard]] auto
+  serialized_size() const noexcept -> size_type
+  {
+    return detail::ipv::serialization::header_size<T> + _size * sizeof(T);
+  }
+
+  [[nodiscard]] auto
+  operator[](size_type pos) const noexcept -> T const&
+  {
+    MTP_EXPECTS(pos < _size);
+    return _data[pos];
+  }
+
+  [[nodiscard]] auto
+  begin() const noexcept -> const_iterator
+  {
+    return _data;
+  }
+
+  [[nodiscard]] auto
+  end() const noexcept -> const_iterator
+  {
+    return _data + _size;
+  }
+
+  [[nodiscard]] auto
+  span() const noexcept -> std::span<T const>
+  {
+    return { _data, _size };
+  }
+
+  [[nodiscard]] auto
+  to_inplace_vector() const -> inplace_vector<T, N>
+  {
+    MTP_EXPECTS(_data != nullptr);
+    return inplace_vector<T, N>(begin(), end());
+  }
+};
+
+// Replaces the contents of `out` with the record at the front of `bytes` in one copy. Returns the
+// end of the record, or nullptr (leaving `out` untouched) when the record is truncated or holds
+// more than N elements. Unlike `serialized_view`, the payload does not have to be aligned.
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+auto
+try_deserialize(std::span<std::byte const> bytes, inplace_vector<T, N>& out) -> std::byte const*
+{
+  namespace s = detail::ipv::serialization;
+  auto const record = s::record_size<T, N>(bytes);
+  if (record == 0)
+    MTP_UNLIKELY
+    {
+      return nullptr;
+    }
+
+  auto const payload = bytes.data() + s::header_size<T>;
+  auto const size = (record - s::header_size<T>) / sizeof(T);
+  if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) == 0) {
+    auto const first = reinterpret_cast<T const*>(payload);
+    out.assign(first, first + size);
+  }
+  else {
+    // misaligned input cannot be read as T: the bytes go straight into the storage (T is trivially
+    // copyable, so the old elements need no destruction), without value-initializing it first
+    if (size > 0) {
+      std::memcpy(out.data(), payload, size * sizeof(T));
+    }
+    detail::ipv::access::set_size(out, size);
+  }
+  return bytes.data() + record;
+}
+
+template <detail::ipv::serialization::wire_type T, std::size_t N>
+[[nodiscard]] auto
+deserialize(std::span<std::byte const> bytes) -> inplace_vector<T, N>
+{
+  auto result = inplace_vector<T, N>{};
+  if (!try_deserialize(bytes, result))
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::length_error("mtp::deserialize"));
+    }
+  return result;
+}
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_SERIALIZATION_HPP
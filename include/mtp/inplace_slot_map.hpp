@@ -0,0 +1,325 @@
+#ifndef MTP_INPLACE_SLOT_MAP_HPP
+#define MTP_INPLACE_SLOT_MAP_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  include <stdexcept>
+#endif
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+// Fixed capacity slot map. Values are stored densely in an `inplace_vector` (iteration is a plain
+// array walk); a slot table maps stable handles to dense positions and threads unused slots into
+// an intrusive free list. Generations are even while a slot is free and odd while it is occupied,
+// so stale handles and never issued handles both fail lookup.
+template <typename T, std::size_t N>
+  requires(N > 0)
+class inplace_slot_map
+{
+public:
+  using value_type = T;
+  using index_type = detail::ipv::storage::smallest_size_t<N>;
+  using generation_type = std::uint32_t;
+  using size_type = std::size_t;
+  using iterator = typename inplace_vector<T, N>::iterator;
+  using const_iterator = typename inplace_vector<T, N>::const_iterator;
+
+  struct handle
+  {
+    index_type index{ 0 };
+    generation_type generation{ 0 };
+
+    [[nodiscard]] explicit constexpr
+    operator bool() const noexcept
+    {
+      return (generation & 1u) != 0;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(handle const&, handle const&) noexcept -> bool = default;
+  };
+
+private:
+  static constexpr auto _npos = static_cast<index_type>(N);
+
+  struct _slot
+  {
+    index_type dense_or_next_free;
+    generation_type generation;
+  };
+
+  inplace_vector<T, N> _values;
+  inplace_vector<index_type, N> _slot_of;
+  inplace_vector<_slot, N> _slots;
+  index_type _free_head{ _npos };
+
+  [[nodiscard]] constexpr auto
+  _find(handle h) const noexcept -> _slot const*
+  {
+    if (h.index >= _slots.size())
+      MTP_UNLIKELY
+      {
+        return nullptr;
+      }
+    auto const& slot = _slots[h.index];
+    return (h && slot.generation == h.generation) ? &slot : nullptr;
+  }
+
+public:
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _values.size();
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return _values.empty();
+  }
+
+  template <typename... Args>
+  constexpr auto
+  emplace(Args&&... args) -> handle
+  {
+    auto const h = try_emplace(std::forward<Args>(args)...);
+    if (!h)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    return h;
+  }
+
+  constexpr auto
+  insert(T const& value) -> handle
+  {
+    return emplace(value);
+  }
+
+  constexpr auto
+  insert(T&& value) -> handle
+  {
+    return emplace(std::move(value));
+  }
+
+  // returns a null handle when full
+  template <typename... Args>
+  constexpr auto
+  try_emplace(Args&&... args) -> handle
+  {
+    if (_values.size() >= N)
+      MTP_UNLIKELY
+      {
+        return handle{};
+      }
+
+    auto const dense = static_cast<index_type>(_values.size());
+    _values.unchecked_emplace_back(std::forward<Args>(args)...);
+
+    auto index = _free_head;
+    if (index != _npos) {
+      _free_head = _slots[index].dense_or_next_free;
+    }
+    else {
+      index = static_cast<index_type>(_slots.size());
+      _slots.unchecked_push_back(_slot{ _npos, 0 });
+    }
+
+    auto& slot = _slots[index];
+    slot.dense_or_next_free = dense;
+    ++slot.generation;
+    _slot_of.unchecked_push_back(index);
+
+    return handle{ index, slot.generation };
+  }
+
+  constexpr auto
+  erase(handle h) -> bool
+  {
+    auto const found = _find(h);
+    if (!found) {
+      return false;
+    }
+
+    auto const dense = found->dense_or_next_free;
+    auto const last = static_cast<index_type>(_values.size() - 1);
+    if (dense != last) {
+      _values[dense] = std::move(_values[last]);
+      _slot_of[dense] = _slot_of[last];
+      _slots[_slot_of[dense]].dense_or_next_free = dense;
+    }
+    _values.pop_back();
+    _slot_of.pop_back();
+
+    auto& slot = _slots[h.index];
+    ++slot.generation;
+    slot.dense_or_next_free = _free_head;
+    _free_head = h.index;
+    return true;
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    for (auto const index : _slot_of) {
+      auto& slot = _slots[index];
+      ++slot.generation;
+      slot.dense_or_next_free = _free_head;
+      _free_head = index;
+    }
+    _values.clear();
+    _slot_of.clear();
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(handle h) const noexcept -> bool
+  {
+    return _find(h) != nullptr;
+  }
+
+  [[nodiscard]] constexpr auto
+  get(handle h) noexcept -> T*
+  {
+    auto const found = _find(h);
+    return found ? _values.data() + found->dense_or_next_free : nullptr;
+  }
+
+  [[nodiscard]] constexpr auto
+  get(handle h) const noexcept -> T const*
+  {
+    auto const found = _find(h);
+    return found ? _values.data() + found->dense_or_next_free : nullptr;
+  }
+
+  [[nodiscard]] constexpr auto
+  at(handle h) -> T&
+  {
+    auto const p = get(h);
+    if (!p)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_slot_map::at"));
+      }
+    return *p;
+  }
+
+  [[nodiscard]] constexpr auto
+  at(handle h) const -> T const&
+  {
+    auto const p = get(h);
+    if (!p)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_slot_map::at"));
+      }
+    return *p;
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](handle h) noexcept -> T&
+  {
+    MTP_EXPECTS(contains(h));
+    return _values[_slots[h.index].dense_or_next_free];
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](handle h) const noexcept -> T const&
+  {
+    MTP_EXPECTS(contains(h));
+    return _values[_slots[h.index].dense_or_next_free];
+  }
+
+  // handle of the value at dense position `pos` (e.g. `it - begin()` while iterating)
+  [[nodiscard]] constexpr auto
+  handle_at(size_type pos) const noexcept -> handle
+  {
+    MTP_EXPECTS(pos < size());
+    auto const index = _slot_of[pos];
+    return handle{ index, _slots[index].generation };
+  }
+
+  [[nodiscard]] constexpr auto
+  values() const noexcept -> inplace_vector<T, N> const&
+  {
+    return _values;
+  }
+
+  [[nodiscard]] constexpr auto
+  data() noexcept -> T*
+  {
+    return _values.data();
+  }
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> T const*
+  {
+    return _values.data();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() noexcept -> iterator
+  {
+    return _values.begin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() noexcept -> iterator
+  {
+    return _values.end();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return _values.begin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return _values.end();
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_SLOT_MAP_HPP
@@ -0,0 +1,265 @@
+#ifndef MTP_INPLACE_SPSC_QUEUE_HPP
+#define MTP_INPLACE_SPSC_QUEUE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+// Bounded wait-free single producer single consumer queue over inline storage. Slots are the
+// uninitialized bytes of `byte_storage`; head and tail are monotonic counters on their own cache
+// lines, each next to the owning side's cached copy of the other index, so a side only touches
+// the other's line when its cached view says the queue is full (empty).
+//
+// One thread may call the producer functions (`try_push`, `try_emplace`, `push_batch`) and one
+// thread the consumer functions (`try_pop`, `front`, `pop`, `pop_batch`). Batches publish all
+// their elements with a single release store. A power of two N keeps slot indexing to a mask.
+template <typename T, std::size_t N>
+  requires(N > 0)
+class inplace_spsc_queue : private detail::ipv::storage::byte_storage<T, N>
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  using _storage = detail::ipv::storage::byte_storage<T, N>;
+  static constexpr auto _line = detail::ipv::concurrency::cache_line_size;
+
+  struct alignas(_line) _producer
+  {
+    std::atomic<size_type> tail{ 0 };
+    size_type cached_head{ 0 };
+  };
+
+  struct alignas(_line) _consumer
+  {
+    std::atomic<size_type> head{ 0 };
+    size_type cached_tail{ 0 };
+  };
+
+  _producer _p;
+  _consumer _c;
+
+  [[nodiscard]] auto
+  _slot(size_type index) noexcept -> T*
+  {
+    return _storage::data() + index % N;
+  }
+
+  // free slots as seen by the producer, refreshing the cached head only when needed
+  [[nodiscard]] auto
+  _room(size_type tail, size_type wanted) noexcept -> size_type
+  {
+    auto room = N - (tail - _p.cached_head);
+    if (room < wanted) {
+      _p.cached_head = _c.head.load(std::memory_order_acquire);
+      room = N - (tail - _p.cached_head);
+    }
+    return room;
+  }
+
+  // filled slots as seen by the consumer, refreshing the cached tail only when needed
+  [[nodiscard]] auto
+  _available(size_type head, size_type wanted) noexcept -> size_type
+  {
+    auto available = _c.cached_tail - head;
+    if (available < wanted) {
+      _c.cached_tail = _p.tail.load(std::memory_order_acquire);
+      available = _c.cached_tail - head;
+    }
+    return available;
+  }
+
+public:
+  inplace_spsc_queue() noexcept = default;
+
+  inplace_spsc_queue(inplace_spsc_queue const&) = delete;
+  auto operator=(inplace_spsc_queue const&) -> inplace_spsc_queue& = delete;
+
+  ~inplace_spsc_queue()
+  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      auto const tail = _p.tail.load(std::memory_order_relaxed);
+      for (auto i = _c.head.load(std::memory_order_relaxed); i != tail; ++i) {
+        std::destroy_at(_slot(i));
+      }
+    }
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  // a snapshot, exact only while neither side is running
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    auto const head = _c.head.load(std::memory_order_acquire);
+    return _p.tail.load(std::memory_order_acquire) - head;
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  // producer
+
+  template <typename... Args>
+  auto
+  try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> bool
+  {
+    auto const tail = _p.tail.load(std::memory_order_relaxed);
+    if (_room(tail, 1) == 0)
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    std::construct_at(_slot(tail), std::forward<Args>(args)...);
+    _p.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  auto
+  try_push(T const& value) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool
+  {
+    return try_emplace(value);
+  }
+
+  auto
+  try_push(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) -> bool
+  {
+    return try_emplace(std::move(value));
+  }
+
+  // Copies the longest prefix of `values` that fits (one bulk copy per contiguous run of slots for
+  // trivially copyable T). Returns the number pushed. If a copy throws, nothing is pushed.
+  auto
+  push_batch(std::span<T const> values) noexcept(std::is_nothrow_copy_constructible_v<T>)
+      -> size_type
+  {
+    auto const tail = _p.tail.load(std::memory_order_relaxed);
+    auto const count = std::min(values.size(), _room(tail, values.size()));
+    if (count == 0) {
+      return 0;
+    }
+
+    auto const first = tail % N;
+    auto const run = std::min(count, N - first);
+    std::uninitialized_copy_n(values.data(), run, _storage::data() + first);
+    if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+      std::uninitialized_copy_n(values.data() + run, count - run, _storage::data());
+    }
+    else {
+      try {
+        std::uninitialized_copy_n(values.data() + run, count - run, _storage::data());
+      } catch (...) {
+        // nothing was published, so the first run is not visible to the consumer yet
+        std::destroy_n(_storage::data() + first, run);
+        throw;
+      }
+    }
+    _p.tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // consumer
+
+  // oldest element, or nullptr when empty; stays valid until `pop()`
+  [[nodiscard]] auto
+  front() noexcept -> T*
+  {
+    auto const head = _c.head.load(std::memory_order_relaxed);
+    return _available(head, 1) == 0 ? nullptr : _slot(head);
+  }
+
+  auto
+  pop() noexcept -> void
+  {
+    auto const head = _c.head.load(std::memory_order_relaxed);
+    MTP_EXPECTS(_c.cached_tail != head);
+    std::destroy_at(_slot(head));
+    _c.head.store(head + 1, std::memory_order_release);
+  }
+
+  auto
+  try_pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) -> bool
+  {
+    auto const head = _c.head.load(std::memory_order_relaxed);
+    if (_available(head, 1) == 0)
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    auto const slot = _slot(head);
+    out = std::move(*slot);
+    std::destroy_at(slot);
+    _c.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves up to `out.size()` elements into `out`. Trivially relocatable elements are relocated
+  // with one memmove per contiguous run of slots. Returns the number popped.
+  auto
+  pop_batch(std::span<T> out) noexcept(std::is_nothrow_destructible_v<T> &&
+                                       std::is_nothrow_move_assignable_v<T>) -> size_type
+  {
+    auto const head = _c.head.load(std::memory_order_relaxed);
+    auto const count = std::min(out.size(), _available(head, out.size()));
+    if (count == 0) {
+      return 0;
+    }
+
+    auto const first = head % N;
+    auto const run = std::min(count, N - first);
+    auto const take = [](T* src, size_type n, T* dest) {
+      if constexpr (is_trivially_relocatable_v<T>) {
+        std::destroy_n(dest, n);
+        std::memmove(static_cast<void*>(dest), src, n * sizeof(T));
+      }
+      else {
+        std::move(src, src + n, dest);
+        std::destroy_n(src, n);
+      }
+    };
+    take(_storage::data() + first, run, out.data());
+    take(_storage::data(), count - run, out.data() + run);
+    _c.head.store(head + count, std::memory_order_release);
+    return count;
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_SPSC_QUEUE_HPP
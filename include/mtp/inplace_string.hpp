@@ -0,0 +1,630 @@
+#ifndef MTP_INPLACE_STRING_HPP
+#define MTP_INPLACE_STRING_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  include <stdexcept>
+#endif
+#include <string_view>
+#include <type_traits>
+
+namespace mtp {
+
+// Fixed capacity string. Layout is `char[N]` followed by the remaining capacity (`N - size()`)
+// stored little endian in `sizeof(smallest_size_t<N>)` bytes. Characters past `size()` are kept
+// zeroed, so the terminator is free: it is either an unused character or, when full, the zero
+// remaining count. The zeroed tail also gives every value a unique object representation, which
+// lets equality compare the whole buffer for small N.
+template <std::size_t N>
+class inplace_string
+{
+public:
+  using traits_type = std::char_traits<char>;
+  using value_type = char;
+  using pointer = char*;
+  using const_pointer = char const*;
+  using reference = char&;
+  using const_reference = char const&;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static constexpr size_type npos = std::string_view::npos;
+
+private:
+  using _remaining_type = detail::ipv::storage::smallest_size_t<N>;
+  static constexpr auto _remaining_bytes = sizeof(_remaining_type);
+
+  // buffers up to this size are compared in one fixed size block
+  static constexpr auto _block_compare_limit = std::size_t{ 64 };
+
+  char _data[N + _remaining_bytes]{};
+
+  constexpr auto
+  _unsafe_set_size(size_type size) noexcept -> void
+  {
+    MTP_EXPECTS(size <= N);
+    auto remaining = static_cast<std::uint64_t>(N - size);
+    for (auto i = 0u; i < _remaining_bytes; ++i, remaining >>= 8) {
+      _data[N + i] = static_cast<char>(remaining & 0xff);
+    }
+  }
+
+  constexpr auto
+  _zero(size_type first, size_type last) noexcept -> void
+  {
+    traits_type::assign(_data + first, last - first, '\0');
+  }
+
+  [[nodiscard]] constexpr auto
+  _block_equal(inplace_string const& other) const noexcept -> bool
+  {
+    if (!std::is_constant_evaluated()) {
+      if constexpr (sizeof(_data) <= _block_compare_limit) {
+        return std::memcmp(_data, other._data, sizeof(_data)) == 0;
+      }
+    }
+    return size() == other.size() && traits_type::compare(data(), other.data(), size()) == 0;
+  }
+
+public:
+  constexpr inplace_string() noexcept
+  {
+    _unsafe_set_size(0);
+  }
+
+  constexpr inplace_string(size_type count, char ch)
+      : inplace_string()
+  {
+    append(count, ch);
+  }
+
+  constexpr inplace_string(char const* s)
+      : inplace_string(std::string_view{ s })
+  {}
+
+  constexpr inplace_string(char const* s, size_type count)
+      : inplace_string(std::string_view{ s, count })
+  {}
+
+  explicit constexpr inplace_string(std::string_view sv)
+      : inplace_string()
+  {
+    append(sv);
+  }
+
+  inplace_string(std::nullptr_t) = delete;
+
+  constexpr auto
+  operator=(std::string_view sv) -> inplace_string&
+  {
+    assign(sv);
+    return *this;
+  }
+
+  constexpr auto
+  operator=(char const* s) -> inplace_string&
+  {
+    assign(std::string_view{ s });
+    return *this;
+  }
+
+  constexpr auto
+  assign(std::string_view sv) -> inplace_string&
+  {
+    if (sv.size() > capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+
+    auto const old_size = size();
+    traits_type::move(_data, sv.data(), sv.size());
+    if (sv.size() < old_size) {
+      _zero(sv.size(), old_size);
+    }
+    _unsafe_set_size(sv.size());
+    return *this;
+  }
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    auto remaining = std::uint64_t{ 0 };
+    for (auto i = _remaining_bytes; i > 0; --i) {
+      remaining = (remaining << 8) | static_cast<unsigned char>(_data[N + i - 1]);
+    }
+    return N - static_cast<size_type>(remaining);
+  }
+
+  [[nodiscard]] constexpr auto
+  length() const noexcept -> size_type
+  {
+    return size();
+  }
+
+  [[nodiscard]] static constexpr auto
+  max_size() noexcept -> size_type
+  {
+    return N;
+  }
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  [[nodiscard]] constexpr auto
+  full() const noexcept -> bool
+  {
+    return size() == N;
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) -> reference
+  {
+    if (pos >= size())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_string::at"));
+      }
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) const -> const_reference
+  {
+    if (pos >= size())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_string::at"));
+      }
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) -> reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) const -> const_reference
+  {
+    MTP_EXPECTS(pos <= size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  data() noexcept -> pointer
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> const_pointer
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  c_str() const noexcept -> const_pointer
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  view() const noexcept -> std::string_view
+  {
+    return std::string_view{ _data, size() };
+  }
+
+  [[nodiscard]] constexpr
+  operator std::string_view() const noexcept
+  {
+    return view();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() noexcept -> iterator
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  end() noexcept -> iterator
+  {
+    return _data + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return _data + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  cend() const noexcept -> const_iterator
+  {
+    return _data + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() noexcept -> reverse_iterator
+  {
+    return reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() noexcept -> reverse_iterator
+  {
+    return reverse_iterator{ begin() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ begin() };
+  }
+
+  constexpr auto
+  push_back(char ch) -> void
+  {
+    if (!try_push_back(ch))
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+  }
+
+  constexpr auto
+  try_push_back(char ch) noexcept -> pointer
+  {
+    auto const old_size = size();
+    if (old_size >= capacity())
+      MTP_UNLIKELY
+      {
+        return nullptr;
+      }
+    _data[old_size] = ch;
+    _unsafe_set_size(old_size + 1);
+    return _data + old_size;
+  }
+
+  constexpr auto
+  pop_back() noexcept -> void
+  {
+    MTP_EXPECTS(!empty());
+    auto const new_size = size() - 1;
+    _data[new_size] = '\0';
+    _unsafe_set_size(new_size);
+  }
+
+  constexpr auto
+  append(std::string_view sv) -> inplace_string&
+  {
+    if (!try_append(sv))
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    return *this;
+  }
+
+  constexpr auto
+  append(size_type count, char ch) -> inplace_string&
+  {
+    auto const old_size = size();
+    if (count > capacity() - old_size)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    traits_type::assign(_data + old_size, count, ch);
+    _unsafe_set_size(old_size + count);
+    return *this;
+  }
+
+  // all or nothing, returns the start of the appended characters or nullptr if `sv` does not fit
+  constexpr auto
+  try_append(std::string_view sv) noexcept -> pointer
+  {
+    auto const old_size = size();
+    if (sv.size() > capacity() - old_size)
+      MTP_UNLIKELY
+      {
+        return nullptr;
+      }
+    traits_type::move(_data + old_size, sv.data(), sv.size());
+    _unsafe_set_size(old_size + sv.size());
+    return _data + old_size;
+  }
+
+  constexpr auto
+  operator+=(std::string_view sv) -> inplace_string&
+  {
+    return append(sv);
+  }
+
+  constexpr auto
+  operator+=(char ch) -> inplace_string&
+  {
+    push_back(ch);
+    return *this;
+  }
+
+  constexpr auto
+  erase(size_type pos = 0, size_type count = npos) -> inplace_string&
+  {
+    auto const old_size = size();
+    if (pos > old_size)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_string::erase"));
+      }
+
+    count = std::min(count, old_size - pos);
+    traits_type::move(_data + pos, _data + pos + count, old_size - pos - count);
+    _zero(old_size - count, old_size);
+    _unsafe_set_size(old_size - count);
+    return *this;
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    _zero(0, size());
+    _unsafe_set_size(0);
+  }
+
+  constexpr auto
+  resize(size_type count, char ch = '\0') -> void
+  {
+    auto const old_size = size();
+    if (count <= old_size) {
+      _zero(count, old_size);
+      _unsafe_set_size(count);
+    }
+    else {
+      append(count - old_size, ch);
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  substr(size_type pos = 0, size_type count = npos) const -> std::string_view
+  {
+    if (pos > size())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::out_of_range("mtp::inplace_string::substr"));
+      }
+    return view().substr(pos, count);
+  }
+
+  [[nodiscard]] constexpr auto
+  find(std::string_view sv, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find(char ch, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(ch, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  rfind(std::string_view sv, size_type pos = npos) const noexcept -> size_type
+  {
+    return view().rfind(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  rfind(char ch, size_type pos = npos) const noexcept -> size_type
+  {
+    return view().rfind(ch, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find_first_of(std::string_view sv, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find_first_of(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find_last_of(std::string_view sv, size_type pos = npos) const noexcept -> size_type
+  {
+    return view().find_last_of(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  starts_with(std::string_view sv) const noexcept -> bool
+  {
+    return view().starts_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  starts_with(char ch) const noexcept -> bool
+  {
+    return view().starts_with(ch);
+  }
+
+  [[nodiscard]] constexpr auto
+  ends_with(std::string_view sv) const noexcept -> bool
+  {
+    return view().ends_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  ends_with(char ch) const noexcept -> bool
+  {
+    return view().ends_with(ch);
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(std::string_view sv) const noexcept -> bool
+  {
+    return find(sv) != npos;
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(char ch) const noexcept -> bool
+  {
+    return find(ch) != npos;
+  }
+
+  [[nodiscard]] constexpr auto
+  compare(std::string_view sv) const noexcept -> int
+  {
+    return view().compare(sv);
+  }
+
+  constexpr auto
+  swap(inplace_string& other) noexcept -> void
+  {
+    std::swap(_data, other._data);
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(inplace_string const& lhs, inplace_string const& rhs) noexcept -> bool
+  {
+    return lhs._block_equal(rhs);
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator<=>(inplace_string const& lhs, inplace_string const& rhs) noexcept
+      -> std::strong_ordering
+  {
+    return lhs.view() <=> rhs.view();
+  }
+
+  // templated so string literals bind here exactly instead of converting to either side
+  template <typename S>
+    requires(std::is_convertible_v<S const&, std::string_view> &&
+             !std::is_same_v<S, inplace_string>)
+  [[nodiscard]] friend constexpr auto
+  operator==(inplace_string const& lhs, S const& rhs) noexcept -> bool
+  {
+    return lhs.view() == std::string_view{ rhs };
+  }
+
+  template <typename S>
+    requires(std::is_convertible_v<S const&, std::string_view> &&
+             !std::is_same_v<S, inplace_string>)
+  [[nodiscard]] friend constexpr auto
+  operator<=>(inplace_string const& lhs, S const& rhs) noexcept -> std::strong_ordering
+  {
+    return lhs.view() <=> std::string_view{ rhs };
+  }
+
+  friend constexpr auto
+  swap(inplace_string& a, inplace_string& b) noexcept -> void
+  {
+    a.swap(b);
+  }
+};
+
+} // namespace mtp
+
+template <std::size_t N>
+struct std::hash<mtp::inplace_string<N>>
+{
+  [[nodiscard]] auto
+  operator()(mtp::inplace_string<N> const& s) const noexcept -> std::size_t
+  {
+    return std::hash<std::string_view>{}(s.view());
+  }
+};
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_STRING_HPP
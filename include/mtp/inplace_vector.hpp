@@ -41,6 +41,7 @@
 #  include <cstddef>
 #  include <cstdint>
 #  include <cstring>
+#  include <functional>
 #  include <initializer_list>
 #  include <iterator>
 #  include <limits>
@@ -78,156 +79,198 @@ using std::uninitialized_move_n;
 using std::uninitialized_value_construct;
 using std::uninitialized_value_construct_n;
 #else
-template <std::input_iterator I, std::sentinel_for<I> S, std::forward_iterator O>
-constexpr auto
-uninitialized_copy(I first, S last, O d_first)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_reference_t<I>>) -> O
+// Function objects rather than functions: for elements declared in namespace std, argument
+// dependent lookup would otherwise prefer the std algorithms, not constexpr before C++26.
+struct uninitialized_copy_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = d_first;
-    try {
-      for (; first != last; ++current, ++first) {
-        std::construct_at(std::to_address(current), *first);
+  template <std::input_iterator I, std::sentinel_for<I> S, std::forward_iterator O>
+  constexpr auto
+  operator()(I first, S last, O d_first) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_reference_t<I>>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = d_first;
+      try {
+        for (; first != last; ++current, ++first) {
+          std::construct_at(std::to_address(current), *first);
+        }
+        return current;
+      } catch (...) {
+        std::destroy(d_first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(d_first, current);
-      throw;
+    }
+    else {
+      return std::uninitialized_copy(first, last, d_first);
     }
   }
-  else {
-    return std::uninitialized_copy(first, last, d_first);
-  }
-}
+};
 
-template <std::input_iterator I, typename SizeT, std::forward_iterator O>
-constexpr auto
-uninitialized_copy_n(I first, SizeT count, O d_first)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_reference_t<I>>) -> O
+inline constexpr auto uninitialized_copy = uninitialized_copy_fn{};
+
+struct uninitialized_copy_n_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = d_first;
-    try {
-      for (; count > 0; ++current, --count) {
-        std::construct_at(std::to_address(current), *first);
+  template <std::input_iterator I, typename SizeT, std::forward_iterator O>
+  constexpr auto
+  operator()(I first, SizeT count, O d_first) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_reference_t<I>>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = d_first;
+      try {
+        for (; count > 0; ++current, ++first, --count) {
+          std::construct_at(std::to_address(current), *first);
+        }
+        return current;
+      } catch (...) {
+        std::destroy(d_first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(d_first, current);
-      throw;
+    }
+    else {
+      return std::uninitialized_copy_n(first, count, d_first);
     }
   }
-  else {
-    return std::uninitialized_copy_n(first, count, d_first);
-  }
-}
+};
 
-template <std::forward_iterator O, std::sentinel_for<O> S, typename T>
-constexpr auto
-uninitialized_fill(O first, S last, T const& value)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, T const&>) -> O
+inline constexpr auto uninitialized_copy_n = uninitialized_copy_n_fn{};
+
+struct uninitialized_fill_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = first;
-    try {
-      for (; current != last; ++current) {
-        std::construct_at(std::to_address(current), value);
+  template <std::forward_iterator O, std::sentinel_for<O> S, typename T>
+  constexpr auto
+  operator()(O first, S last, T const& value) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, T const&>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = first;
+      try {
+        for (; current != last; ++current) {
+          std::construct_at(std::to_address(current), value);
+        }
+        return current;
+      } catch (...) {
+        std::destroy(first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(first, current);
-      throw;
+    }
+    else {
+      std::uninitialized_fill(first, last, value);
+      return last;
     }
   }
-  else {
-    std::uninitialized_fill(first, last, value);
-    return last;
-  }
-}
+};
 
-template <std::forward_iterator O, typename SizeT, typename T>
-constexpr auto
-uninitialized_fill_n(O first, SizeT count, T const& value)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, T const&>) -> O
+inline constexpr auto uninitialized_fill = uninitialized_fill_fn{};
+
+struct uninitialized_fill_n_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = first;
-    try {
-      for (; count > 0; ++current, --count) {
-        std::construct_at(std::to_address(current), value);
+  template <std::forward_iterator O, typename SizeT, typename T>
+  constexpr auto
+  operator()(O first, SizeT count, T const& value) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, T const&>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = first;
+      try {
+        for (; count > 0; ++current, --count) {
+          std::construct_at(std::to_address(current), value);
+        }
+        return current;
+      } catch (...) {
+        std::destroy(first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(first, current);
-      throw;
+    }
+    else {
+      return std::uninitialized_fill_n(first, count, value);
     }
   }
-  else {
-    return std::uninitialized_fill_n(first, count, value);
-  }
-}
+};
 
-template <std::input_iterator I, std::sentinel_for<I> S, std::forward_iterator O>
-constexpr auto
-uninitialized_move(I first, S last, O d_first)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_rvalue_reference_t<I>>)
-        -> O
+inline constexpr auto uninitialized_fill_n = uninitialized_fill_n_fn{};
+
+struct uninitialized_move_fn
 {
-  return uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last), d_first);
-}
+  template <std::input_iterator I, std::sentinel_for<I> S, std::forward_iterator O>
+  constexpr auto
+  operator()(I first, S last, O d_first) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_rvalue_reference_t<I>>)
+          -> O
+  {
+    return uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last), d_first);
+  }
+};
 
-template <std::input_iterator I, typename SizeT, std::forward_iterator O>
-constexpr auto
-uninitialized_move_n(I first, SizeT count, O d_first)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_rvalue_reference_t<I>>)
-        -> O
+inline constexpr auto uninitialized_move = uninitialized_move_fn{};
+
+struct uninitialized_move_n_fn
 {
-  return uninitialized_copy_n(std::make_move_iterator(first), count, d_first);
-}
+  template <std::input_iterator I, typename SizeT, std::forward_iterator O>
+  constexpr auto
+  operator()(I first, SizeT count, O d_first) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>, std::iter_rvalue_reference_t<I>>)
+          -> O
+  {
+    return uninitialized_copy_n(std::make_move_iterator(first), count, d_first);
+  }
+};
 
-template <std::forward_iterator O, std::sentinel_for<O> S>
-constexpr auto
-uninitialized_value_construct(O first, S last)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>>) -> O
+inline constexpr auto uninitialized_move_n = uninitialized_move_n_fn{};
+
+struct uninitialized_value_construct_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = first;
-    try {
-      for (; current != last; ++current) {
-        std::construct_at(std::to_address(current));
+  template <std::forward_iterator O, std::sentinel_for<O> S>
+  constexpr auto
+  operator()(O first, S last) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = first;
+      try {
+        for (; current != last; ++current) {
+          std::construct_at(std::to_address(current));
+        }
+        return current;
+      } catch (...) {
+        std::destroy(first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(first, current);
-      throw;
+    }
+    else {
+      return std::uninitialized_value_construct(first, last);
     }
   }
-  else {
-    return std::uninitialized_value_construct(first, last);
-  }
-}
+};
 
-template <std::forward_iterator O, typename SizeT>
-constexpr auto
-uninitialized_value_construct_n(O first, SizeT count)
-    noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>>) -> O
+inline constexpr auto uninitialized_value_construct = uninitialized_value_construct_fn{};
+
+struct uninitialized_value_construct_n_fn
 {
-  if (std::is_constant_evaluated()) {
-    auto current = first;
-    try {
-      for (; count > 0; ++current, --count) {
-        std::construct_at(std::to_address(current));
+  template <std::forward_iterator O, typename SizeT>
+  constexpr auto
+  operator()(O first, SizeT count) const
+      noexcept(std::is_nothrow_constructible_v<std::iter_value_t<O>>) -> O
+  {
+    if (std::is_constant_evaluated()) {
+      auto current = first;
+      try {
+        for (; count > 0; ++current, --count) {
+          std::construct_at(std::to_address(current));
+        }
+        return current;
+      } catch (...) {
+        std::destroy(first, current);
+        throw;
       }
-      return current;
-    } catch (...) {
-      std::destroy(first, current);
-      throw;
+    }
+    else {
+      return std::uninitialized_value_construct_n(first, count);
     }
   }
-  else {
-    return std::uninitialized_value_construct_n(first, count);
-  }
-}
+};
+
+inline constexpr auto uninitialized_value_construct_n = uninitialized_value_construct_n_fn{};
 #endif // __cpp_lib_raw_memory_algorithms >= 202411L
 
 MTP_EXPORT template <typename T>
@@ -252,7 +295,7 @@ relocate_at(T* dest, T* src) noexcept(is_nothrow_relocatable_v<T>) -> T*
 {
   if (!std::is_constant_evaluated()) {
     if constexpr (is_trivially_relocatable_v<T>) {
-      std::memmove(dest, src, sizeof(T));
+      std::memmove(static_cast<void*>(dest), static_cast<void const*>(src), sizeof(T));
       return dest;
     }
   }
@@ -281,7 +324,8 @@ uninitialized_relocate(I first, S last, O d_first)
     constexpr auto is_contiguous = std::contiguous_iterator<I> && std::contiguous_iterator<O>;
     if constexpr (is_contiguous && std::is_same_v<T, U> && is_trivially_relocatable_v<T>) {
       auto const count = static_cast<std::size_t>(last - first);
-      std::memmove(std::to_address(d_first), std::to_address(first), count * sizeof(T));
+      std::memmove(static_cast<void*>(std::to_address(d_first)),
+                   static_cast<void const*>(std::to_address(first)), count * sizeof(T));
       return d_first + count;
     }
   }
@@ -312,7 +356,8 @@ uninitialized_relocate_n(I first, SizeT count, O d_first)
   if (!std::is_constant_evaluated()) {
     constexpr auto is_contiguous = std::contiguous_iterator<I> && std::contiguous_iterator<O>;
     if constexpr (is_contiguous && std::is_same_v<T, U> && is_trivially_relocatable_v<T>) {
-      std::memmove(std::to_address(d_first), std::to_address(first), count * sizeof(T));
+      std::memmove(static_cast<void*>(std::to_address(d_first)),
+                   static_cast<void const*>(std::to_address(first)), count * sizeof(T));
       return d_first + count;
     }
   }
@@ -343,7 +388,8 @@ uninitialized_relocate_backward(I first, S last, O d_last)
     constexpr auto is_contiguous = std::contiguous_iterator<I> && std::contiguous_iterator<O>;
     if constexpr (is_contiguous && std::is_same_v<T, U> && is_trivially_relocatable_v<T>) {
       auto const count = static_cast<std::size_t>(last - first);
-      std::memmove(std::to_address(d_last - count), std::to_address(first), count * sizeof(T));
+      std::memmove(static_cast<void*>(std::to_address(d_last - count)),
+                   static_cast<void const*>(std::to_address(first)), count * sizeof(T));
       return d_last - count;
     }
   }
@@ -407,6 +453,13 @@ protected:
     return _size;
   }
 
+  // no size object, the capacity is always 0
+  [[nodiscard]] constexpr auto
+  size_data() noexcept -> size_type*
+  {
+    return nullptr;
+  }
+
   [[nodiscard]] constexpr auto
   data() noexcept -> T*
   {
@@ -433,6 +486,16 @@ private:
   size_type _size{ 0 };
 
 protected:
+  constexpr typed_storage() noexcept
+  {
+    // constant expressions must not contain indeterminate values (only runtime can skip init)
+    if (std::is_constant_evaluated()) {
+      for (auto& elem : _data) {
+        std::construct_at(std::addressof(elem));
+      }
+    }
+  }
+
   constexpr auto
   set_size(size_type size) noexcept -> void
   {
@@ -446,6 +509,12 @@ protected:
     return _size;
   }
 
+  [[nodiscard]] constexpr auto
+  size_data() noexcept -> size_type*
+  {
+    return std::addressof(_size);
+  }
+
   [[nodiscard]] static constexpr auto
   capacity() noexcept -> size_type
   {
@@ -465,6 +534,15 @@ protected:
   }
 };
 
+// Uninitialized storage for any T: the array is a member of an anonymous union, so unlike bytes
+// reinterpreted as T, its elements can be constructed and used during constant evaluation. At
+// runtime the layout and the (absent) initialization are those of an aligned byte array.
+//
+// Slots are constructed when they are used. The result of a constant expression must not leave
+// an element of the active array uninitialized though, so a `constexpr` vector that is not full
+// only persists if its spare slots hold values: they are default constructed during constant
+// evaluation for trivially destructible T, where overwriting them later skips no destructor and
+// their construction cannot allocate. For other T only full `constexpr` vectors persist.
 template <typename T, std::size_t N>
 class byte_storage
 {
@@ -472,10 +550,35 @@ public:
   using size_type = smallest_size_t<N>;
 
 private:
-  alignas(T) std::byte _data[N * sizeof(T)];
+  union {
+    T _data[N];
+  };
   size_type _size{ 0 };
 
 protected:
+  constexpr byte_storage() noexcept
+  {
+    if constexpr (std::is_default_constructible_v<T> && std::is_trivially_destructible_v<T>) {
+      if (std::is_constant_evaluated()) {
+        for (auto& elem : _data) {
+          std::construct_at(std::addressof(elem));
+        }
+      }
+    }
+  }
+
+  byte_storage(byte_storage const&) = default;
+  byte_storage(byte_storage&&) = default;
+  auto operator=(byte_storage const&) -> byte_storage& = default;
+  auto operator=(byte_storage&&) -> byte_storage& = default;
+
+  // the elements are destroyed by the owner, which knows how many there are
+  ~byte_storage()
+    requires(std::is_trivially_destructible_v<T>)
+  = default;
+
+  constexpr ~byte_storage() {}
+
   constexpr auto
   set_size(size_type size) noexcept -> void
   {
@@ -489,6 +592,12 @@ protected:
     return _size;
   }
 
+  [[nodiscard]] constexpr auto
+  size_data() noexcept -> size_type*
+  {
+    return std::addressof(_size);
+  }
+
   [[nodiscard]] static constexpr auto
   capacity() noexcept -> size_type
   {
@@ -498,13 +607,13 @@ protected:
   [[nodiscard]] constexpr auto
   data() noexcept -> T*
   {
-    return reinterpret_cast<T*>(_data);
+    return static_cast<T*>(_data);
   }
 
   [[nodiscard]] constexpr auto
   data() const noexcept -> T const*
   {
-    return reinterpret_cast<T const*>(_data);
+    return static_cast<T const*>(_data);
   }
 };
 
@@ -523,6 +632,32 @@ using storage_type = std::conditional_t<
 
 } // namespace detail::ipv::storage
 
+namespace detail::ipv::concurrency {
+
+// fixed rather than `std::hardware_destructive_interference_size`, which is not stable across
+// compiler flags (GCC warns about using it in headers)
+inline constexpr auto cache_line_size = std::size_t{ 64 };
+
+} // namespace detail::ipv::concurrency
+
+// what conversions into an `inplace_vector` do with elements past the capacity
+MTP_EXPORT enum class overflow
+{
+  throw_exception, // throws `std::bad_alloc`
+  truncate,        // keeps the first N elements
+  unchecked,       // the elements must fit
+};
+
+// capacity erased view, see inplace_vector_ref.hpp
+template <typename T>
+class inplace_vector_ref;
+
+namespace detail::ipv {
+
+struct access;
+
+} // namespace detail::ipv
+
 MTP_EXPORT template <typename T, std::size_t N>
 class inplace_vector : private detail::ipv::storage::storage_type<T, N>
 {
@@ -542,12 +677,38 @@ public:
 private:
   using _storage = detail::ipv::storage::storage_type<T, N>;
 
+  friend class inplace_vector_ref<T>;
+  friend struct detail::ipv::access;
+
+  template <typename U, std::size_t M>
+  friend class inplace_vector;
+
   constexpr auto
   _unsafe_set_size(size_type size) noexcept -> void
   {
     _storage::set_size(static_cast<_storage::size_type>(size));
   }
 
+  // appends the elements of an `ipv` of another capacity by relocation, `ipv` ends up empty
+  template <std::size_t M>
+  constexpr auto
+  _relocate_from(inplace_vector<T, M>& ipv) -> void
+  {
+    auto const count = ipv.size();
+    if (count > capacity() - size())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    if (count > 0) {
+      // a throwing relocation destroys every source element, so `ipv` is emptied first
+      ipv._unsafe_set_size(0);
+      using detail::ipv::memory::uninitialized_relocate_n;
+      uninitialized_relocate_n(ipv.data(), count, data() + size());
+      _unsafe_set_size(size() + count);
+    }
+  }
+
   [[nodiscard]] constexpr auto
   _is_valid_iterator(const_iterator pos) const noexcept -> bool
   {
@@ -646,6 +807,53 @@ public:
     return *this;
   }
 
+  // Conversions from other capacities, explicit when the elements may not fit; they throw
+  // `std::bad_alloc`, changing nothing, when they do not. The rvalue forms relocate the elements
+  // (one `memmove` for trivially relocatable T) and leave `ipv` empty.
+  template <std::size_t M>
+    requires(M != N)
+  constexpr explicit(M > N) inplace_vector(inplace_vector<T, M> const& ipv)
+  {
+    insert(data(), ipv.begin(), ipv.end());
+  }
+
+  template <std::size_t M>
+    requires(M != N)
+  constexpr explicit(M > N) inplace_vector(inplace_vector<T, M>&& ipv)
+      noexcept(M < N && is_nothrow_relocatable_v<value_type>)
+  {
+    _relocate_from(ipv);
+  }
+
+  template <std::size_t M>
+    requires(M != N)
+  constexpr auto
+  operator=(inplace_vector<T, M> const& ipv) -> inplace_vector&
+  {
+    if (ipv.size() > capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    assign(ipv.begin(), ipv.end());
+    return *this;
+  }
+
+  template <std::size_t M>
+    requires(M != N)
+  constexpr auto
+  operator=(inplace_vector<T, M>&& ipv) -> inplace_vector&
+  {
+    if (ipv.size() > capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    clear();
+    _relocate_from(ipv);
+    return *this;
+  }
+
   constexpr ~inplace_vector() noexcept(std::is_nothrow_destructible_v<value_type>)
   {
     clear();
@@ -718,6 +926,7 @@ public:
 
     if (first == last) {
       std::destroy(it, old_end);
+      _unsafe_set_size(static_cast<size_type>(it - data()));
     }
     else {
       for (; first != last; ++first) {
@@ -749,8 +958,8 @@ public:
     else {
       using detail::ipv::memory::uninitialized_copy;
       uninitialized_copy(first, last, it);
-      _unsafe_set_size(count);
     }
+    _unsafe_set_size(count);
   }
 
   template <detail::ipv::concepts::container_compatible_range<value_type> R>
@@ -1025,7 +1234,8 @@ public:
   template <detail::ipv::concepts::container_compatible_range<value_type> R>
   constexpr auto append_range(R&& rg) -> void
   {
-    auto const it = try_append_range(std::forward<R>(rg));
+    // as an lvalue, so that an rvalue range yields an iterator rather than `std::ranges::dangling`
+    auto const it = try_append_range(rg);
     if (it != std::ranges::end(rg))
       MTP_UNLIKELY
       {
@@ -1268,7 +1478,7 @@ public:
   constexpr auto
   erase(const_iterator pos) -> iterator
   {
-    erase(pos, pos + 1);
+    return erase(pos, pos + 1);
   }
 
   constexpr auto
@@ -1299,6 +1509,88 @@ public:
     erase(data(), data() + size());
   }
 
+  // Moves [first, last) of `other` (which must not be *this) to before `pos`. For trivially
+  // relocatable T this is three `memmove`s: opening the gap, filling it and closing the hole in
+  // `other`. Throws `std::bad_alloc`, changing nothing, when the elements do not fit.
+  template <std::size_t M>
+  constexpr auto
+  splice(const_iterator pos, inplace_vector<T, M>& other, const_iterator first,
+         const_iterator last) -> iterator
+  {
+    MTP_EXPECTS(static_cast<void const*>(std::addressof(other)) != this);
+    MTP_EXPECTS(_is_valid_iterator(pos) && other._is_valid_iterator_pair(first, last));
+
+    auto const count = static_cast<size_type>(last - first);
+    if (count > capacity() - size())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+
+    auto const it = data() + (pos - data());
+    if (count == 0) {
+      return it;
+    }
+
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      using detail::ipv::memory::uninitialized_relocate;
+      using detail::ipv::memory::uninitialized_relocate_backward;
+      using detail::ipv::memory::uninitialized_relocate_n;
+      auto const old_end = data() + size();
+      auto const src = other.data() + (first - other.data());
+      uninitialized_relocate_backward(it, old_end, old_end + count);
+      uninitialized_relocate_n(src, count, it);
+      uninitialized_relocate(src + count, other.data() + other.size(), src);
+      _unsafe_set_size(size() + count);
+      other._unsafe_set_size(other.size() - count);
+    }
+    else {
+      auto const src = other.data() + (first - other.data());
+      insert(pos, std::make_move_iterator(src), std::make_move_iterator(src + count));
+      other.erase(first, last);
+    }
+    return it;
+  }
+
+  template <std::size_t M>
+  constexpr auto
+  splice(const_iterator pos, inplace_vector<T, M>& other) -> iterator
+  {
+    return splice(pos, other, other.begin(), other.end());
+  }
+
+  // Relocates the last `count` elements into a new `inplace_vector<T, M>`, in order.
+  template <std::size_t M = N>
+  [[nodiscard]] constexpr auto
+  extract_back(size_type count) -> inplace_vector<T, M>
+  {
+    MTP_EXPECTS(count <= size());
+    if (count > M)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+
+    inplace_vector<T, M> out; // not value-initialized, that would zero all M elements first
+    if (count > 0) {
+      // a throwing relocation destroys every source element
+      auto const first = data() + size() - count;
+      _unsafe_set_size(size() - count);
+      using detail::ipv::memory::uninitialized_relocate_n;
+      uninitialized_relocate_n(first, count, out.data());
+      out._unsafe_set_size(count);
+    }
+    return out;
+  }
+
+  // Relocates the elements from `pos` on into a new vector, keeping [0, pos).
+  [[nodiscard]] constexpr auto
+  split_at(size_type pos) -> inplace_vector
+  {
+    MTP_EXPECTS(pos <= size());
+    return extract_back(size() - pos);
+  }
+
   constexpr auto swap(inplace_vector& ipv)
       noexcept(N == 0 ||
                (std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)) -> void
@@ -1402,8 +1694,121 @@ struct is_trivially_relocatable<inplace_vector<T, N>>
     : std::bool_constant<N == 0 || is_trivially_relocatable_v<T>>
 {};
 
+namespace detail::ipv {
+
+// For extension headers that construct or relocate elements straight into the uninitialized tail
+// of an `inplace_vector` and then publish them.
+struct access
+{
+  template <typename T, std::size_t N>
+  static constexpr auto
+  set_size(inplace_vector<T, N>& ipv, std::size_t size) noexcept -> void
+  {
+    ipv._unsafe_set_size(size);
+  }
+
+  // the size object, for code writing out the object representation without its padding
+  template <typename T, std::size_t N>
+  [[nodiscard]] static constexpr auto
+  size_data(inplace_vector<T, N> const& ipv) noexcept
+  {
+    auto const* const size = const_cast<inplace_vector<T, N>&>(ipv).size_data();
+    return size;
+  }
+};
+
+} // namespace detail::ipv
+
+namespace detail::ipv::hash {
+
+inline constexpr auto k0 = std::uint64_t{ 0x9e3779b97f4a7c15 };
+inline constexpr auto k1 = std::uint64_t{ 0xbf58476d1ce4e5b9 };
+inline constexpr auto k2 = std::uint64_t{ 0x94d049bb133111eb };
+
+// folded 64x64->128 bit multiply
+inline auto
+mix(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128; // not ISO C++, quiet under -Wpedantic
+  auto const product = static_cast<uint128>(a) * b;
+  return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+  // high half without the carry out of the low half, close enough for hashing
+  auto const lo = a * b;
+  auto const hi = (a >> 32) * (b >> 32) + (((a >> 32) * (b & 0xffffffff)) >> 32) +
+                  (((a & 0xffffffff) * (b >> 32)) >> 32);
+  return lo ^ hi;
+#endif
+}
+
+inline auto
+load(std::byte const* p, std::size_t count = 8) noexcept -> std::uint64_t
+{
+  auto word = std::uint64_t{ 0 };
+  std::memcpy(&word, p, count);
+  return word;
+}
+
+// Non-cryptographic byte hash in the style of wyhash: one folded multiply per 16 bytes.
+inline auto
+bytes(void const* data, std::size_t size) noexcept -> std::uint64_t
+{
+  auto p = static_cast<std::byte const*>(data);
+  auto h = k0 ^ size;
+  auto rest = size;
+  for (; rest > 16; rest -= 16, p += 16) {
+    h = mix(load(p) ^ k1, load(p + 8) ^ h);
+  }
+  auto const lo = rest > 8 ? load(p) : (rest > 0 ? load(p, rest) : 0);
+  auto const hi = rest > 8 ? load(p + 8, rest - 8) : 0;
+  return mix(mix(lo ^ k1, hi ^ h), size ^ k2);
+}
+
+} // namespace detail::ipv::hash
+
+// Hashes the elements of a vector; the capacity does not take part, so equal vectors of different
+// capacity hash alike. Elements with unique object representations are hashed as one run of
+// bytes, others by combining `std::hash<T>` and need it to be enabled. Specialize for an element
+// type to plug in another hash function.
+MTP_EXPORT template <typename T>
+struct inplace_vector_hash
+{
+  [[nodiscard]] auto
+  operator()(T const* data, std::size_t size) const noexcept -> std::size_t
+    requires(std::has_unique_object_representations_v<T> ||
+             std::is_default_constructible_v<std::hash<T>>)
+  {
+    namespace h = detail::ipv::hash;
+    if constexpr (std::has_unique_object_representations_v<T>) {
+      return static_cast<std::size_t>(h::bytes(data, size * sizeof(T)));
+    }
+    else {
+      auto result = h::k0 ^ size;
+      for (auto i = std::size_t{ 0 }; i < size; ++i) {
+        result = h::mix(result ^ static_cast<std::uint64_t>(std::hash<T>{}(data[i])), h::k1);
+      }
+      return static_cast<std::size_t>(h::mix(result, h::k2));
+    }
+  }
+};
+
 } // namespace mtp
 
+// enabled only when the elements are hashable, so that e.g. `std::unordered_set` rejects vectors
+// of unhashable elements up front
+template <typename T, std::size_t N>
+  requires(std::is_invocable_r_v<std::size_t, mtp::inplace_vector_hash<T> const&, T const*,
+                                 std::size_t>)
+struct std::hash<mtp::inplace_vector<T, N>>
+{
+  [[nodiscard]] auto
+  operator()(mtp::inplace_vector<T, N> const& ipv) const noexcept -> std::size_t
+  {
+    return mtp::inplace_vector_hash<T>{}(ipv.data(), ipv.size());
+  }
+};
+
 #undef MTP_EXPORT
 #undef MTP_EXPECTS
 #undef MTP_THROW
@@ -0,0 +1,499 @@
+#ifndef MTP_INPLACE_VECTOR_ARRAY_HPP
+#define MTP_INPLACE_VECTOR_ARRAY_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mtp {
+
+// A growable array of rows that each behave like an `inplace_vector<T, N>`, stored as columns: the
+// row sizes are one contiguous array of `smallest_size_t<N>` and the row buffers one slab of
+// N-element slots. Scans over the sizes (`total_size`, `count_if_size`) read only the size column,
+// a byte per row for N < 256, and vectorize. Rows are accessed through `row`, a mutable view with
+// the `inplace_vector` modifiers that writes back to the size column.
+//
+// Growing the slab relocates the rows (one `memcpy` for trivially relocatable T), so T must be
+// nothrow relocatable and views are invalidated by any operation that adds rows.
+template <typename T, std::size_t N>
+  requires(N > 0 && is_nothrow_relocatable_v<T>)
+class inplace_vector_array
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using row_size_type = detail::ipv::storage::smallest_size_t<N>;
+  using const_row = std::span<T const>;
+
+  class row
+  {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+  private:
+    T* _data;
+    row_size_type* _size;
+
+    friend class inplace_vector_array;
+
+    row(T* data, row_size_type* size) noexcept
+        : _data(data)
+        , _size(size)
+    {
+    }
+
+  public:
+    [[nodiscard]] auto
+    size() const noexcept -> size_type
+    {
+      return *_size;
+    }
+
+    [[nodiscard]] static constexpr auto
+    capacity() noexcept -> size_type
+    {
+      return N;
+    }
+
+    [[nodiscard]] auto
+    empty() const noexcept -> bool
+    {
+      return *_size == 0;
+    }
+
+    [[nodiscard]] auto
+    data() const noexcept -> T*
+    {
+      return _data;
+    }
+
+    [[nodiscard]] auto
+    begin() const noexcept -> iterator
+    {
+      return _data;
+    }
+
+    [[nodiscard]] auto
+    end() const noexcept -> iterator
+    {
+      return _data + *_size;
+    }
+
+    [[nodiscard]] auto
+    operator[](size_type pos) const noexcept -> T&
+    {
+      MTP_EXPECTS(pos < size());
+      return _data[pos];
+    }
+
+    [[nodiscard]] auto
+    front() const noexcept -> T&
+    {
+      MTP_EXPECTS(!empty());
+      return _data[0];
+    }
+
+    [[nodiscard]] auto
+    back() const noexcept -> T&
+    {
+      MTP_EXPECTS(!empty());
+      return _data[size() - 1];
+    }
+
+    template <typename... Args>
+    auto
+    unchecked_emplace_back(Args&&... args) const -> T&
+    {
+      MTP_EXPECTS(size() < N);
+      auto const it = std::construct_at(_data + size(), std::forward<Args>(args)...);
+      ++*_size;
+      return *it;
+    }
+
+    template <typename... Args>
+    auto
+    try_emplace_back(Args&&... args) const -> T*
+    {
+      if (size() == N)
+        MTP_UNLIKELY
+        {
+          return nullptr;
+        }
+      return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    auto
+    emplace_back(Args&&... args) const -> T&
+    {
+      if (size() == N)
+        MTP_UNLIKELY
+        {
+          MTP_THROW(std::bad_alloc());
+        }
+      return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    auto
+    push_back(T const& value) const -> T&
+    {
+      return emplace_back(value);
+    }
+
+    auto
+    push_back(T&& value) const -> T&
+    {
+      return emplace_back(std::move(value));
+    }
+
+    auto
+    try_push_back(T const& value) const -> T*
+    {
+      return try_emplace_back(value);
+    }
+
+    auto
+    try_push_back(T&& value) const -> T*
+    {
+      return try_emplace_back(std::move(value));
+    }
+
+    // Appends the longest prefix of `rg` that fits, as one bulk copy for sized ranges. Returns an
+    // iterator to the first element not appended.
+    template <detail::ipv::concepts::container_compatible_range<T> R>
+    auto
+    try_append_range(R&& rg) const -> std::ranges::borrowed_iterator_t<R>
+    {
+      auto first = std::ranges::begin(rg);
+      if constexpr (std::ranges::sized_range<R> && std::ranges::random_access_range<R>) {
+        auto const count = std::min<size_type>(N - size(), std::ranges::size(rg));
+        using detail::ipv::memory::uninitialized_copy;
+        uninitialized_copy(first, first + count, end());
+        *_size += static_cast<row_size_type>(count);
+        return first + count;
+      }
+      else {
+        for (; first != std::ranges::end(rg) && try_emplace_back(*first); ++first) {
+        }
+        return first;
+      }
+    }
+
+    template <detail::ipv::concepts::container_compatible_range<T> R>
+    auto
+    append_range(R&& rg) const -> void
+    {
+      if constexpr (std::ranges::sized_range<R>) {
+        if (std::ranges::size(rg) > N - size())
+          MTP_UNLIKELY
+          {
+            MTP_THROW(std::bad_alloc());
+          }
+      }
+      if (try_append_range(rg) != std::ranges::end(rg))
+        MTP_UNLIKELY
+        {
+          MTP_THROW(std::bad_alloc());
+        }
+    }
+
+    auto
+    pop_back() const -> void
+    {
+      MTP_EXPECTS(!empty());
+      std::destroy_at(_data + size() - 1);
+      --*_size;
+    }
+
+    auto
+    clear() const noexcept -> void
+    {
+      std::destroy_n(_data, size());
+      *_size = 0;
+    }
+
+    [[nodiscard]]
+    operator std::span<T const>() const noexcept
+    {
+      return { _data, size() };
+    }
+
+    [[nodiscard]] auto
+    to_inplace_vector() const -> inplace_vector<T, N>
+    {
+      return inplace_vector<T, N>(begin(), end());
+    }
+  };
+
+private:
+  struct _slot
+  {
+    alignas(T) std::byte bytes[N * sizeof(T)];
+  };
+
+  std::vector<row_size_type> _sizes;
+  std::unique_ptr<_slot[]> _slots;
+  size_type _capacity{ 0 };
+
+  [[nodiscard]] auto
+  _data(size_type r) const noexcept -> T*
+  {
+    return reinterpret_cast<T*>(_slots[r].bytes);
+  }
+
+  auto
+  _destroy_rows(size_type first) noexcept -> void
+  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (auto r = first; r < size(); ++r) {
+        std::destroy_n(_data(r), _sizes[r]);
+      }
+    }
+  }
+
+public:
+  inplace_vector_array() noexcept = default;
+
+  explicit inplace_vector_array(size_type rows)
+  {
+    resize(rows);
+  }
+
+  inplace_vector_array(inplace_vector_array const& other)
+  {
+    reserve(other.size());
+    for (auto r = size_type{ 0 }; r < other.size(); ++r) {
+      push_back(other[r]);
+    }
+  }
+
+  inplace_vector_array(inplace_vector_array&& other) noexcept
+      : _sizes(std::exchange(other._sizes, {}))
+      , _slots(std::move(other._slots))
+      , _capacity(std::exchange(other._capacity, 0))
+  {
+  }
+
+  auto
+  operator=(inplace_vector_array const& other) -> inplace_vector_array&
+  {
+    if (this != &other) {
+      auto copy = other;
+      swap(copy);
+    }
+    return *this;
+  }
+
+  auto
+  operator=(inplace_vector_array&& other) noexcept -> inplace_vector_array&
+  {
+    auto moved = std::move(other);
+    swap(moved);
+    return *this;
+  }
+
+  ~inplace_vector_array()
+  {
+    _destroy_rows(0);
+  }
+
+  auto
+  swap(inplace_vector_array& other) noexcept -> void
+  {
+    _sizes.swap(other._sizes);
+    _slots.swap(other._slots);
+    std::swap(_capacity, other._capacity);
+  }
+
+  // rows
+
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return _sizes.size();
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return _sizes.empty();
+  }
+
+  // rows that fit before the slab is reallocated
+  [[nodiscard]] auto
+  capacity() const noexcept -> size_type
+  {
+    return _capacity;
+  }
+
+  [[nodiscard]] static constexpr auto
+  row_capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  auto
+  reserve(size_type rows) -> void
+  {
+    if (rows <= _capacity) {
+      return;
+    }
+    // everything that can throw happens before the first element moves
+    _sizes.reserve(rows);
+    auto slots = std::make_unique_for_overwrite<_slot[]>(rows);
+    if (size() > 0) {
+      if constexpr (is_trivially_relocatable_v<T>) {
+        std::memcpy(static_cast<void*>(slots.get()), _slots.get(), size() * sizeof(_slot));
+      }
+      else {
+        using detail::ipv::memory::uninitialized_relocate_n;
+        for (auto r = size_type{ 0 }; r < size(); ++r) {
+          uninitialized_relocate_n(_data(r), _sizes[r], reinterpret_cast<T*>(slots[r].bytes));
+        }
+      }
+    }
+    _slots = std::move(slots);
+    _capacity = rows;
+  }
+
+  // new rows are empty
+  auto
+  resize(size_type rows) -> void
+  {
+    if (rows < size()) {
+      _destroy_rows(rows);
+    }
+    else {
+      reserve(rows);
+    }
+    _sizes.resize(rows, 0);
+  }
+
+  auto
+  clear() noexcept -> void
+  {
+    _destroy_rows(0);
+    _sizes.clear();
+  }
+
+  // appends an empty row
+  auto
+  emplace_back() -> row
+  {
+    if (size() == _capacity) {
+      reserve(std::max<size_type>(2 * _capacity, 8));
+    }
+    _sizes.push_back(0);
+    return (*this)[size() - 1];
+  }
+
+  auto
+  push_back(std::span<T const> values) -> row
+  {
+    if (values.size() > N)
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    auto const r = emplace_back();
+    static_cast<void>(r.try_append_range(values));
+    return r;
+  }
+
+  auto
+  pop_back() -> void
+  {
+    MTP_EXPECTS(!empty());
+    (*this)[size() - 1].clear();
+    _sizes.pop_back();
+  }
+
+  [[nodiscard]] auto
+  operator[](size_type r) noexcept -> row
+  {
+    MTP_EXPECTS(r < size());
+    return row(_data(r), _sizes.data() + r);
+  }
+
+  [[nodiscard]] auto
+  operator[](size_type r) const noexcept -> const_row
+  {
+    MTP_EXPECTS(r < size());
+    return { _data(r), _sizes[r] };
+  }
+
+  // size column scans
+
+  [[nodiscard]] auto
+  sizes() const noexcept -> std::span<row_size_type const>
+  {
+    return _sizes;
+  }
+
+  // number of elements in all rows
+  [[nodiscard]] auto
+  total_size() const noexcept -> size_type
+  {
+    auto total = size_type{ 0 };
+    for (auto const size : _sizes) {
+      total += size;
+    }
+    return total;
+  }
+
+  // number of rows whose size satisfies `pred`, counted without branches
+  template <typename Pred>
+    requires(std::is_invocable_r_v<bool, Pred&, size_type>)
+  [[nodiscard]] auto
+  count_if_size(Pred pred) const -> size_type
+  {
+    auto count = size_type{ 0 };
+    for (auto const size : _sizes) {
+      count += static_cast<size_type>(static_cast<bool>(std::invoke(pred, size_type{ size })));
+    }
+    return count;
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_VECTOR_ARRAY_HPP
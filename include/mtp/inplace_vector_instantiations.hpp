@@ -0,0 +1,22 @@
+#ifndef MTP_INPLACE_VECTOR_INSTANTIATIONS_HPP
+#define MTP_INPLACE_VECTOR_INSTANTIATIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// The `inplace_vector<T, N>` specializations compiled once into the library by the module build
+// with `MTP_EXPLICIT_INSTANTIATIONS`, as an X-macro calling `X(T, N)` for each. Header-only users
+// can expand it into `extern template` declarations and definitions of their own.
+#define MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, T) X(T, 8) X(T, 16) X(T, 32) X(T, 64)
+
+#define MTP_INPLACE_VECTOR_INSTANTIATIONS(X)                                                       \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, char)                                                     \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, int)                                                      \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, float)                                                    \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, double)                                                   \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, std::byte)                                                \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, std::uint8_t)                                             \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, std::uint32_t)                                            \
+  MTP_INPLACE_VECTOR_INSTANTIATIONS_N(X, std::uint64_t)
+
+#endif // MTP_INPLACE_VECTOR_INSTANTIATIONS_HPP
@@ -0,0 +1,89 @@
+#ifndef MTP_INPLACE_VECTOR_INTEROP_HPP
+#define MTP_INPLACE_VECTOR_INTEROP_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace mtp {
+
+// Takes the elements of `vec` and leaves it empty, keeping its allocation. Trivially relocatable,
+// trivially destructible elements are relocated with one `memcpy` (the vector's `clear` then runs
+// no destructors), others are moved. Elements past N are handled according to `Policy`;
+// `overflow::throw_exception` leaves `vec` untouched.
+template <std::size_t N, overflow Policy = overflow::throw_exception, typename T, typename Alloc>
+[[nodiscard]] constexpr auto
+from_vector(std::vector<T, Alloc>&& vec) -> inplace_vector<T, N>
+{
+  auto count = vec.size();
+  if (count > N) {
+    if constexpr (Policy == overflow::throw_exception) {
+      MTP_THROW(std::bad_alloc());
+    }
+    else if constexpr (Policy == overflow::unchecked) {
+      MTP_EXPECTS(count <= N);
+    }
+    count = N;
+  }
+
+  inplace_vector<T, N> ipv;
+  if (count > 0) {
+    if constexpr (is_trivially_relocatable_v<T> && std::is_trivially_destructible_v<T>) {
+      using detail::ipv::memory::uninitialized_relocate_n;
+      uninitialized_relocate_n(vec.data(), count, ipv.data());
+    }
+    else {
+      using detail::ipv::memory::uninitialized_move;
+      uninitialized_move(vec.data(), vec.data() + count, ipv.data());
+    }
+    detail::ipv::access::set_size(ipv, count);
+  }
+  vec.clear();
+  return ipv;
+}
+
+// Moves the elements of `ipv` into a `std::vector` with one allocation and leaves `ipv` empty.
+// Trivially copyable elements are copied with one `memcpy`.
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>>
+[[nodiscard]] constexpr auto
+into_vector(inplace_vector<T, N>&& ipv, Alloc const& alloc = Alloc()) -> std::vector<T, Alloc>
+{
+  auto vec = std::vector<T, Alloc>(alloc);
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    vec.assign(ipv.begin(), ipv.end());
+    detail::ipv::access::set_size(ipv, 0);
+  }
+  else {
+    vec.assign(std::make_move_iterator(ipv.begin()), std::make_move_iterator(ipv.end()));
+    ipv.clear();
+  }
+  return vec;
+}
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+
+#endif // MTP_INPLACE_VECTOR_INTEROP_HPP
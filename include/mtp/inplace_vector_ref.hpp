@@ -0,0 +1,409 @@
+#ifndef MTP_INPLACE_VECTOR_REF_HPP
+#define MTP_INPLACE_VECTOR_REF_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace mtp {
+
+namespace detail::ipv::ref {
+
+// Pointer to the size of an `inplace_vector<T, N>`, whose type is `smallest_size_t<N>`: the width
+// is kept next to the pointer and every access switches on it.
+class size_ref
+{
+  // one typed pointer per width rather than a `void*`, which constant evaluation cannot cast back
+  union
+  {
+    std::uint8_t* _u8{ nullptr };
+    std::uint16_t* _u16;
+    std::uint32_t* _u32;
+    std::uint64_t* _u64;
+  };
+  unsigned char _width{ 0 }; // 0 for N == 0, which has no size object
+
+public:
+  constexpr size_ref() noexcept = default;
+
+  template <typename SizeT>
+    requires(std::is_same_v<SizeT, std::uint8_t> || std::is_same_v<SizeT, std::uint16_t> ||
+             std::is_same_v<SizeT, std::uint32_t> || std::is_same_v<SizeT, std::uint64_t>)
+  constexpr explicit size_ref(SizeT* size) noexcept
+  {
+    if (size == nullptr) {
+      return;
+    }
+    if constexpr (sizeof(SizeT) == 1) {
+      _u8 = size;
+    }
+    else if constexpr (sizeof(SizeT) == 2) {
+      _u16 = size;
+    }
+    else if constexpr (sizeof(SizeT) == 4) {
+      _u32 = size;
+    }
+    else {
+      _u64 = size;
+    }
+    _width = sizeof(SizeT);
+  }
+
+  [[nodiscard]] constexpr auto
+  load() const noexcept -> std::size_t
+  {
+    switch (_width) {
+    case 1: return *_u8;
+    case 2: return *_u16;
+    case 4: return *_u32;
+    case 8: return static_cast<std::size_t>(*_u64);
+    default: return 0;
+    }
+  }
+
+  constexpr auto
+  store(std::size_t size) const noexcept -> void
+  {
+    switch (_width) {
+    case 1: *_u8 = static_cast<std::uint8_t>(size); break;
+    case 2: *_u16 = static_cast<std::uint16_t>(size); break;
+    case 4: *_u32 = static_cast<std::uint32_t>(size); break;
+    case 8: *_u64 = static_cast<std::uint64_t>(size); break;
+    default: MTP_EXPECTS(size == 0);
+    }
+  }
+};
+
+} // namespace detail::ipv::ref
+
+// Non-owning, capacity erased view of an `inplace_vector<T, N>` for any N: a data pointer, a
+// pointer to the vector's size and the capacity. Functions taking `inplace_vector_ref<T>` accept
+// every capacity without being templates on N, and the modifiers below are compiled once per T
+// instead of once per `inplace_vector<T, N>`. Modifying through the view modifies the vector; the
+// view must not outlive it.
+//
+// Like a pointer, the view is const and its target is not: all members are const.
+template <typename T>
+class inplace_vector_ref
+{
+public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using reference = T&;
+  using const_reference = T const&;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+private:
+  T* _data{ nullptr };
+  detail::ipv::ref::size_ref _size;
+  size_type _capacity{ 0 };
+
+  constexpr auto
+  _unsafe_set_size(size_type size) const noexcept -> void
+  {
+    MTP_EXPECTS(size <= _capacity);
+    _size.store(size);
+  }
+
+  [[nodiscard]] constexpr auto
+  _is_valid_iterator(const_iterator pos) const noexcept -> bool
+  {
+    return begin() <= pos && pos <= end();
+  }
+
+public:
+  template <std::size_t N>
+  constexpr inplace_vector_ref(inplace_vector<T, N>& ipv) noexcept
+      : _data(ipv.data())
+      , _size(ipv.size_data())
+      , _capacity(N)
+  {
+  }
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _size.load();
+  }
+
+  [[nodiscard]] constexpr auto
+  capacity() const noexcept -> size_type
+  {
+    return _capacity;
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> pointer
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> iterator
+  {
+    return _data;
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> iterator
+  {
+    return _data + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) const noexcept -> reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return _data[size() - 1];
+  }
+
+  [[nodiscard]] constexpr
+  operator std::span<T>() const noexcept
+  {
+    return { _data, size() };
+  }
+
+  template <typename... Args>
+  constexpr auto
+  unchecked_emplace_back(Args&&... args) const -> reference
+  {
+    MTP_EXPECTS(size() < capacity());
+    auto const it = std::construct_at(end(), std::forward<Args>(args)...);
+    _unsafe_set_size(size() + 1);
+    return *it;
+  }
+
+  template <typename... Args>
+  constexpr auto
+  try_emplace_back(Args&&... args) const -> pointer
+  {
+    if (size() >= capacity())
+      MTP_UNLIKELY
+      {
+        return nullptr;
+      }
+    return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  constexpr auto
+  emplace_back(Args&&... args) const -> reference
+  {
+    if (size() >= capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+    return unchecked_emplace_back(std::forward<Args>(args)...);
+  }
+
+  constexpr auto
+  push_back(value_type const& value) const -> reference
+  {
+    return emplace_back(value);
+  }
+
+  constexpr auto
+  push_back(value_type&& value) const -> reference
+  {
+    return emplace_back(std::move(value));
+  }
+
+  constexpr auto
+  try_push_back(value_type const& value) const -> pointer
+  {
+    return try_emplace_back(value);
+  }
+
+  constexpr auto
+  try_push_back(value_type&& value) const -> pointer
+  {
+    return try_emplace_back(std::move(value));
+  }
+
+  constexpr auto
+  pop_back() const -> void
+  {
+    MTP_EXPECTS(!empty());
+    std::destroy_at(end() - 1);
+    _unsafe_set_size(size() - 1);
+  }
+
+  template <typename... Args>
+  constexpr auto
+  emplace(const_iterator pos, Args&&... args) const -> iterator
+  {
+    MTP_EXPECTS(_is_valid_iterator(pos));
+    if (size() >= capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+
+    auto const it = _data + (pos - _data);
+    auto const old_end = end();
+
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      using detail::ipv::memory::uninitialized_relocate_backward;
+      uninitialized_relocate_backward(it, old_end, old_end + 1);
+      try {
+        std::construct_at(it, std::forward<Args>(args)...);
+        _unsafe_set_size(size() + 1);
+      } catch (...) {
+        using detail::ipv::memory::uninitialized_relocate;
+        uninitialized_relocate(it + 1, old_end + 1, it);
+        throw;
+      }
+    }
+    else {
+      unchecked_emplace_back(std::forward<Args>(args)...);
+      std::rotate(it, old_end, old_end + 1);
+    }
+
+    return it;
+  }
+
+  constexpr auto
+  insert(const_iterator pos, value_type const& value) const -> iterator
+  {
+    return emplace(pos, value);
+  }
+
+  constexpr auto
+  insert(const_iterator pos, value_type&& value) const -> iterator
+  {
+    return emplace(pos, std::move(value));
+  }
+
+  constexpr auto
+  insert(const_iterator pos, size_type count, value_type const& value) const -> iterator
+  {
+    MTP_EXPECTS(_is_valid_iterator(pos));
+    if (count + size() > capacity())
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::bad_alloc());
+      }
+
+    auto const it = _data + (pos - _data);
+    auto const old_end = end();
+
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      using detail::ipv::memory::uninitialized_relocate_backward;
+      uninitialized_relocate_backward(it, old_end, old_end + count);
+      try {
+        using detail::ipv::memory::uninitialized_fill_n;
+        uninitialized_fill_n(it, count, value);
+      } catch (...) {
+        using detail::ipv::memory::uninitialized_relocate;
+        uninitialized_relocate(it + count, old_end + count, it);
+        throw;
+      }
+    }
+    else {
+      using detail::ipv::memory::uninitialized_fill_n;
+      uninitialized_fill_n(old_end, count, value);
+      std::rotate(it, old_end, old_end + count);
+    }
+    _unsafe_set_size(size() + count);
+
+    return it;
+  }
+
+  constexpr auto
+  erase(const_iterator pos) const -> iterator
+  {
+    return erase(pos, pos + 1);
+  }
+
+  constexpr auto
+  erase(const_iterator first, const_iterator last) const -> iterator
+  {
+    MTP_EXPECTS(_is_valid_iterator(first) && _is_valid_iterator(last) && first <= last);
+
+    auto const it = _data + (first - _data);
+    auto const old_end = end();
+    auto const count = static_cast<size_type>(last - first);
+
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      using detail::ipv::memory::uninitialized_relocate;
+      std::destroy(it, it + count);
+      uninitialized_relocate(it + count, old_end, it);
+    }
+    else {
+      std::destroy(std::move(it + count, old_end, it), old_end);
+    }
+    _unsafe_set_size(size() - count);
+
+    return it;
+  }
+
+  constexpr auto
+  clear() const noexcept(std::is_nothrow_destructible_v<value_type>) -> void
+  {
+    std::destroy(begin(), end());
+    _unsafe_set_size(0);
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_VECTOR_REF_HPP
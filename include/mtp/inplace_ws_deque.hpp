@@ -0,0 +1,175 @@
+#ifndef MTP_INPLACE_WS_DEQUE_HPP
+#define MTP_INPLACE_WS_DEQUE_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace mtp {
+
+// Chase-Lev work-stealing deque over a fixed ring of N slots, after Lê, Pop, Cohen and Zappa
+// Nardelli, "Correct and efficient work-stealing for weak memory models" (PPoPP 2013). The owner
+// pushes and pops at the bottom, thieves steal from the top. The ring never grows: `try_push` fails
+// when N elements are queued and the caller runs the task itself.
+//
+// Thieves read a slot while the owner may be refilling it, so slots are `std::atomic<T>` rather
+// than uninitialized bytes, which limits T to trivially copyable types that are lock-free as an
+// atomic (task pointers, indices, small handles).
+template <typename T, std::size_t N>
+  requires(std::has_single_bit(N) && std::is_trivially_copyable_v<T> &&
+           std::atomic<T>::is_always_lock_free)
+class inplace_ws_deque
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  using _index = std::int64_t;
+  static constexpr auto _line = detail::ipv::concurrency::cache_line_size;
+  static constexpr auto _mask = static_cast<_index>(N - 1);
+
+  // top is written by thieves, bottom by the owner
+  alignas(_line) std::atomic<_index> _top{ 0 };
+  alignas(_line) std::atomic<_index> _bottom{ 0 };
+  alignas(_line) std::array<std::atomic<T>, N> _slots{};
+
+  [[nodiscard]] auto
+  _slot(_index index) noexcept -> std::atomic<T>&
+  {
+    return _slots[static_cast<size_type>(index & _mask)];
+  }
+
+public:
+  inplace_ws_deque() noexcept = default;
+
+  inplace_ws_deque(inplace_ws_deque const&) = delete;
+  auto operator=(inplace_ws_deque const&) -> inplace_ws_deque& = delete;
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  // a snapshot, exact only while no thread is running
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    auto const top = _top.load(std::memory_order_acquire);
+    auto const bottom = _bottom.load(std::memory_order_acquire);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  // owner
+
+  auto
+  try_push(T value) noexcept -> bool
+  {
+    auto const bottom = _bottom.load(std::memory_order_relaxed);
+    auto const top = _top.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<_index>(N))
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    _slot(bottom).store(value, std::memory_order_relaxed);
+    // release rather than the paper's fence + relaxed store, the same cost on x86 and visible to
+    // race detectors
+    _bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // newest element; competes with thieves only for the last one
+  auto
+  try_pop(T& out) noexcept -> bool
+  {
+    auto const bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    out = _slot(bottom).load(std::memory_order_relaxed);
+    if (top != bottom) {
+      return true;
+    }
+    auto const won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // thieves
+
+  // Oldest element. Fails when the deque is empty or another thread took the element first;
+  // either way the thief moves on to another victim.
+  auto
+  try_steal(T& out) noexcept -> bool
+  {
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return false;
+    }
+    auto const value = _slot(top).load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+    out = value;
+    return true;
+  }
+
+  // Steals up to half of the queued elements (rounded up, at most `out.size()`), oldest first.
+  // Each element is claimed with its own CAS: the owner pops without one while more than one
+  // element is left, so claiming a range at once could hand the same element to both. Returns
+  // the number stolen, which is less than planned when the owner or other thieves got there first.
+  auto
+  steal_half(std::span<T> out) noexcept -> size_type
+  {
+    auto const top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return 0;
+    }
+    auto const planned = std::min(out.size(), static_cast<size_type>(bottom - top + 1) / 2);
+    auto stolen = size_type{ 0 };
+    while (stolen < planned && try_steal(out[stolen])) {
+      ++stolen;
+    }
+    return stolen;
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_UNLIKELY
+
+#endif // MTP_INPLACE_WS_DEQUE_HPP
@@ -0,0 +1,163 @@
+#ifndef MTP_SEQLOCK_INPLACE_VECTOR_HPP
+#define MTP_SEQLOCK_INPLACE_VECTOR_HPP
+
+#include <mtp/inplace_vector.hpp>
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace mtp {
+
+// An `inplace_vector<T, N>` published by one writer and copied out by any number of readers
+// without locks, for small tables that are read far more often than written. The contents live in
+// relaxed atomic words (size, then the elements' bytes) guarded by a sequence counter that is odd
+// while a write is in progress; a reader copies all words, a fixed-size block regardless of the
+// current size, and retries when the counter moved. Readers never write shared memory, so they
+// scale with the number of cores; a writer is never blocked by readers.
+//
+// Writers must be serialized by the caller.
+template <typename T, std::size_t N>
+  requires(std::is_trivially_copyable_v<T>)
+class seqlock_inplace_vector
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using snapshot_type = inplace_vector<T, N>;
+
+private:
+  using _word = std::uint64_t;
+  static constexpr auto _line = detail::ipv::concurrency::cache_line_size;
+  static constexpr auto _header = std::max(sizeof(_word), alignof(T));
+  static constexpr auto _words = (_header + N * sizeof(T) + sizeof(_word) - 1) / sizeof(_word);
+
+  // a plain copy of the words, aligned to be read as T
+  struct _block
+  {
+    alignas(std::max(alignof(_word), alignof(T))) std::byte bytes[_words * sizeof(_word)];
+  };
+
+  alignas(_line) std::atomic<std::uint64_t> _sequence{ 0 };
+  alignas(_line) std::array<std::atomic<_word>, _words> _data{};
+
+public:
+  seqlock_inplace_vector() noexcept = default;
+
+  explicit seqlock_inplace_vector(snapshot_type const& ipv) noexcept
+  {
+    publish(ipv);
+  }
+
+  seqlock_inplace_vector(seqlock_inplace_vector const&) = delete;
+  auto operator=(seqlock_inplace_vector const&) -> seqlock_inplace_vector& = delete;
+
+  [[nodiscard]] static constexpr auto
+  capacity() noexcept -> size_type
+  {
+    return N;
+  }
+
+  // number of completed `publish` calls; readers holding a snapshot of the same version can skip
+  // the copy
+  [[nodiscard]] auto
+  version() const noexcept -> std::uint64_t
+  {
+    return _sequence.load(std::memory_order_acquire) / 2;
+  }
+
+  // writer
+
+  auto
+  publish(snapshot_type const& ipv) noexcept -> void
+  {
+    auto block = _block{};
+    auto const size = static_cast<_word>(ipv.size());
+    std::memcpy(block.bytes, &size, sizeof(size));
+    if (!ipv.empty()) {
+      std::memcpy(block.bytes + _header, ipv.data(), ipv.size() * sizeof(T));
+    }
+    // words past the new size keep stale bytes, readers never look at them
+    auto const used = (_header + ipv.size() * sizeof(T) + sizeof(_word) - 1) / sizeof(_word);
+
+    auto const sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (auto i = size_type{ 0 }; i < used; ++i) {
+      auto word = _word{};
+      std::memcpy(&word, block.bytes + i * sizeof(_word), sizeof(word));
+      _data[i].store(word, std::memory_order_relaxed);
+    }
+    _sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // readers
+
+  // One attempt at a consistent copy into `out`; false, with `out` untouched, when a write was in
+  // progress.
+  auto
+  try_load(snapshot_type& out) const -> bool
+  {
+    auto const sequence = _sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0)
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+
+    _block block; // every byte is overwritten below
+    for (auto i = size_type{ 0 }; i < _words; ++i) {
+      auto const word = _data[i].load(std::memory_order_relaxed);
+      std::memcpy(block.bytes + i * sizeof(_word), &word, sizeof(word));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_sequence.load(std::memory_order_relaxed) != sequence)
+      MTP_UNLIKELY
+      {
+        return false;
+      }
+
+    auto size = _word{};
+    std::memcpy(&size, block.bytes, sizeof(size));
+    MTP_EXPECTS(size <= N);
+    auto const first = reinterpret_cast<T const*>(block.bytes + _header);
+    out.assign(first, first + size);
+    return true;
+  }
+
+  [[nodiscard]] auto
+  load() const -> snapshot_type
+  {
+    snapshot_type snapshot;
+    while (!try_load(snapshot)) {
+    }
+    return snapshot;
+  }
+};
+
+} // namespace mtp
+
+#undef MTP_EXPECTS
+#undef MTP_UNLIKELY
+
+#endif // MTP_SEQLOCK_INPLACE_VECTOR_HPP
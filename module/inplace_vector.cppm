@@ -18,6 +18,7 @@ module;
 #  include <cstddef>
 #  include <cstdint>
 #  include <cstring>
+#  include <functional>
 #  include <initializer_list>
 #  include <iterator>
 #  include <limits>
@@ -33,6 +34,10 @@ module;
 #  include <utility>
 #endif
 
+#ifdef MTP_EXPLICIT_INSTANTIATIONS
+#  include <mtp/inplace_vector_instantiations.hpp>
+#endif
+
 // -------------------------------------------------------------------------------------------------
 
 export module mtp.inplace_vector;
@@ -48,3 +53,13 @@ import std;
 #define MTP_BUILD_MODULE
 #define MTP_EXPORT export
 #include <mtp/inplace_vector.hpp>
+
+#ifdef MTP_EXPLICIT_INSTANTIATIONS
+// defined in inplace_vector_instantiations.cpp; reachable from importers, which then use the
+// library's copies instead of instantiating their own
+#  define MTP_EXTERN_TEMPLATE(T, N) extern template class inplace_vector<T, N>;
+namespace mtp {
+MTP_INPLACE_VECTOR_INSTANTIATIONS(MTP_EXTERN_TEMPLATE)
+} // namespace mtp
+#  undef MTP_EXTERN_TEMPLATE
+#endif
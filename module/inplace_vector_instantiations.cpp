@@ -0,0 +1,25 @@
+module;
+
+#if !defined(MTP_USE_STD_MODULE) && defined(__cpp_lib_modules)
+#  define MTP_USE_STD_MODULE
+#endif
+
+#ifndef MTP_USE_STD_MODULE
+#  include <cstddef>
+#  include <cstdint>
+#endif
+
+#include <mtp/inplace_vector_instantiations.hpp>
+
+module mtp.inplace_vector;
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#endif
+
+// the explicit instantiation definitions matching the declarations in inplace_vector.cppm
+#define MTP_INSTANTIATE(T, N) template class inplace_vector<T, N>;
+namespace mtp {
+MTP_INPLACE_VECTOR_INSTANTIATIONS(MTP_INSTANTIATE)
+} // namespace mtp
+#undef MTP_INSTANTIATE
@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <mtp/atomic_inplace_vector.hpp>
+
+namespace {
+
+using mtp::atomic_inplace_vector;
+using mtp::inplace_vector;
+
+} // namespace
+
+TEST_CASE("atomic_inplace_vector single thread", "[atomic_inplace_vector]")
+{
+  auto v = atomic_inplace_vector<int, 8>{};
+  CHECK(v.empty());
+  CHECK(v.committed().empty());
+
+  CHECK(v.try_push(1));
+  CHECK(v.try_emplace(2));
+  auto const values = std::array{ 3, 4, 5, 6, 7 };
+  CHECK(v.push_batch(values) == 5);
+  CHECK(v.size() == 7);
+  CHECK(v.committed().size() == 7);
+  CHECK(v.committed()[6] == 7);
+
+  // the batch that crosses the end is cut short, later ones fail
+  CHECK(v.push_batch(values) == 1);
+  CHECK(v.push_batch(values) == 0);
+  CHECK(!v.try_push(9));
+  CHECK(v.size() == 8);
+
+  auto out = inplace_vector<int, 16>{ 0 };
+  CHECK(v.drain_into(out) == 8);
+  CHECK(out == inplace_vector<int, 16>{ 0, 1, 2, 3, 4, 5, 6, 7, 3 });
+  CHECK(v.empty());
+  CHECK(v.committed().empty());
+
+  // slots are reused after a drain
+  CHECK(v.try_push(10));
+  CHECK(v.committed().size() == 1);
+  CHECK(v.committed()[0] == 10);
+
+  // non-trivial elements are moved out, the rest are destroyed with the buffer
+  auto owners = atomic_inplace_vector<std::unique_ptr<int>, 4>{};
+  CHECK(owners.try_push(std::make_unique<int>(1)));
+  CHECK(owners.try_emplace(new int(2)));
+  auto moved = inplace_vector<std::unique_ptr<int>, 4>{};
+  CHECK(owners.drain_into(moved) == 2);
+  REQUIRE(moved.size() == 2);
+  CHECK(*moved[1] == 2);
+  CHECK(owners.try_push(std::make_unique<int>(3)));
+
+  // what does not fit in `out` stays in the buffer, in order
+  CHECK(owners.try_push(std::make_unique<int>(4)));
+  CHECK(owners.try_push(std::make_unique<int>(5)));
+  moved.push_back(nullptr);
+  CHECK(owners.drain_into(moved) == 1);
+  CHECK(*moved[3] == 3);
+  REQUIRE(owners.committed().size() == 2);
+  CHECK(*owners.committed()[0] == 4);
+  CHECK(owners.drain_into(moved) == 0);
+  CHECK(owners.try_push(std::make_unique<int>(6)));
+  moved.clear();
+  CHECK(owners.drain_into(moved) == 3);
+  CHECK(*moved[0] == 4);
+  CHECK(*moved[2] == 6);
+  CHECK(owners.empty());
+}
+
+TEST_CASE("atomic_inplace_vector producers and a draining consumer", "[atomic_inplace_vector]")
+{
+  constexpr auto producers = 4u;
+  constexpr auto per_producer = std::uint32_t{ 50'000 };
+  auto buffer = atomic_inplace_vector<std::uint32_t, 256>{};
+  auto finished = std::atomic<unsigned>{ 0 };
+
+  // values are producer << 24 | sequence
+  auto threads = std::vector<std::thread>{};
+  for (auto p = 0u; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      auto batch = std::array<std::uint32_t, 4>{};
+      for (auto next = std::uint32_t{ 0 }; next < per_producer;) {
+        if (next % 2 == 0) {
+          auto const n = std::min<std::uint32_t>(batch.size(), per_producer - next);
+          for (auto i = 0u; i < n; ++i) {
+            batch[i] = p << 24 | (next + i);
+          }
+          next += buffer.push_batch(std::span(batch).first(n));
+        }
+        else if (buffer.try_push(p << 24 | next)) {
+          ++next;
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+      finished.fetch_add(1, std::memory_order_release);
+    });
+  }
+
+  auto last = std::array<std::int64_t, producers>{ -1, -1, -1, -1 };
+  auto in_order = true;
+  auto received = std::uint64_t{ 0 };
+  auto flushed = inplace_vector<std::uint32_t, 256>{};
+  auto const take = [&] {
+    // a producer's own elements keep their order within and across drains
+    for (auto const value : flushed) {
+      auto const p = value >> 24;
+      auto const sequence = static_cast<std::int64_t>(value & 0xffffff);
+      in_order &= sequence == last[p] + 1;
+      last[p] = sequence;
+    }
+    received += flushed.size();
+    flushed.clear();
+  };
+  for (;;) {
+    auto const done = finished.load(std::memory_order_acquire) == producers;
+    if (!done && buffer.committed().size() < 64) {
+      std::this_thread::yield();
+      continue;
+    }
+    buffer.drain_into(flushed);
+    take();
+    if (done) {
+      break;
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(in_order);
+  CHECK(received == producers * per_producer);
+  CHECK(buffer.empty());
+}
@@ -0,0 +1,243 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mtp/inplace_algorithm.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+template <typename T, std::size_t N>
+auto
+check_sort(std::mt19937& rng) -> void
+{
+  auto dist = std::uniform_int_distribution<long long>{ -1000, 1000 };
+  for (auto size = std::size_t{ 0 }; size <= N; size += (N < 64 ? 1 : N / 16)) {
+    auto ipv = inplace_vector<T, N>{};
+    for (auto i = 0u; i < size; ++i) {
+      ipv.push_back(static_cast<T>(dist(rng)));
+    }
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+      if (size > 0) {
+        ipv[0] = std::numeric_limits<T>::infinity();
+      }
+    }
+
+    auto expected = std::vector<T>(ipv.begin(), ipv.end());
+    std::sort(expected.begin(), expected.end());
+    mtp::sort(ipv);
+    CHECK(ipv.size() == size);
+    CHECK(std::equal(ipv.begin(), ipv.end(), expected.begin(), expected.end()));
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("sort", "[inplace_algorithm]", int, unsigned, std::int8_t, std::uint16_t,
+                   std::int64_t, float, double)
+{
+  using T = TestType;
+  auto rng = std::mt19937{ 42 };
+  check_sort<T, 1>(rng);
+  check_sort<T, 2>(rng);
+  check_sort<T, 7>(rng);
+  check_sort<T, 16>(rng);
+  check_sort<T, 32>(rng);
+  check_sort<T, 33>(rng);
+  check_sort<T, 512>(rng);
+}
+
+TEST_CASE("sort non arithmetic and custom order", "[inplace_algorithm]")
+{
+  auto ipv = inplace_vector<std::vector<int>, 4>{ { 3 }, { 1, 2 }, { 1 }, {} };
+  mtp::sort(ipv);
+  CHECK(ipv == inplace_vector<std::vector<int>, 4>{ {}, { 1 }, { 1, 2 }, { 3 } });
+
+  auto ints = inplace_vector<int, 8>{ 1, 5, 2, 4 };
+  mtp::sort(ints, std::greater<>{});
+  CHECK(ints == inplace_vector<int, 8>{ 5, 4, 2, 1 });
+
+  constexpr auto sorted = []() {
+    auto v = inplace_vector<int, 4>{ 3, 1, 2 };
+    mtp::sort(v);
+    return v[0] * 100 + v[1] * 10 + v[2];
+  }();
+  static_assert(sorted == 123);
+}
+
+namespace {
+
+enum class color : std::uint16_t
+{
+  red,
+  green,
+  blue
+};
+
+template <typename T, std::size_t N>
+auto
+check_search() -> void
+{
+  for (auto size = std::size_t{ 0 }; size <= N; ++size) {
+    auto ipv = inplace_vector<T, N>{};
+    for (auto i = 0u; i < size; ++i) {
+      ipv.push_back(static_cast<T>(i % 5));
+    }
+
+    for (auto v = 0; v < 7; ++v) {
+      auto const value = static_cast<T>(v);
+      auto const expected = std::find(ipv.begin(), ipv.end(), value);
+      CHECK(mtp::find(ipv, value) == expected);
+      CHECK(mtp::index_of(ipv, value) == static_cast<std::size_t>(expected - ipv.begin()));
+      CHECK(mtp::contains(ipv, value) == (expected != ipv.end()));
+      CHECK(mtp::count(ipv, value) ==
+            static_cast<std::size_t>(std::count(ipv.begin(), ipv.end(), value)));
+    }
+  }
+}
+
+// sorted inputs drawn from [0, range): small ranges give duplicates, `unique` turns them into sets
+template <typename T, std::size_t N>
+auto
+make_sorted(std::mt19937& rng, std::size_t size, int range, bool unique) -> inplace_vector<T, N>
+{
+  auto dist = std::uniform_int_distribution<int>{ 0, range - 1 };
+  auto values = std::vector<T>(size);
+  for (auto& v : values) {
+    v = static_cast<T>(dist(rng));
+  }
+  std::sort(values.begin(), values.end());
+  if (unique) {
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+  }
+  return inplace_vector<T, N>(values.begin(), values.end());
+}
+
+template <typename T>
+auto
+check_set_operations(std::mt19937& rng) -> void
+{
+  constexpr auto N = std::size_t{ 64 };
+  for (auto round = 0; round < 200; ++round) {
+    auto const unique = round % 2 == 0;
+    auto const range = round % 3 == 0 ? 16 : 256;
+    auto const a = make_sorted<T, N>(rng, rng() % (N + 1), range, unique);
+    auto const b = make_sorted<T, N>(rng, rng() % (N + 1), range, unique);
+
+    auto expected = std::vector<T>{};
+    auto out = inplace_vector<T, 2 * N>{ T{ 1 } };
+
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    mtp::set_intersection(a, b, out);
+    CHECK(std::equal(out.begin() + 1, out.end(), expected.begin(), expected.end()));
+
+    expected.clear();
+    out.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    mtp::set_union(a, b, out);
+    CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+    expected.clear();
+    out.clear();
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    mtp::merge(a, b, out);
+    CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+    // a destination too small for the worst case still succeeds when the result fits
+    auto small = inplace_vector<T, 8>{};
+    auto const fits = expected.size() <= small.capacity();
+    CHECK(mtp::try_merge(a, b, small) == fits);
+    CHECK(std::equal(small.begin(), small.end(), expected.begin(),
+                     expected.begin() + static_cast<std::ptrdiff_t>(small.size())));
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("search", "[inplace_algorithm]", std::int8_t, std::uint16_t, std::uint32_t,
+                   std::int64_t, float, double, color)
+{
+  using T = TestType;
+  check_search<T, 1>();
+  check_search<T, 3>();
+  check_search<T, 16>();
+  check_search<T, 37>();
+  check_search<T, 64>();
+}
+
+TEST_CASE("search floating point semantics", "[inplace_algorithm]")
+{
+  auto const ipv = inplace_vector<double, 8>{ 1.0, -0.0, std::numeric_limits<double>::quiet_NaN() };
+  CHECK(mtp::index_of(ipv, 0.0) == 1);
+  CHECK(!mtp::contains(ipv, std::numeric_limits<double>::quiet_NaN()));
+
+  auto const strings = inplace_vector<std::vector<int>, 4>{ { 1 }, { 2 }, { 1 } };
+  CHECK(mtp::count(strings, std::vector<int>{ 1 }) == 2);
+  CHECK(mtp::index_of(strings, std::vector<int>{ 2 }) == 1);
+}
+
+TEST_CASE("search with a value of another type", "[inplace_algorithm]")
+{
+  // the value converts to the element type instead of taking part in deduction
+  auto ipv = inplace_vector<std::uint32_t, 64>{ 3, 5, 5 };
+  CHECK(!mtp::contains(inplace_vector<std::uint32_t, 64>{}, 5));
+  CHECK(mtp::contains(ipv, 5));
+  CHECK(mtp::index_of(ipv, 5) == 1);
+  CHECK(mtp::count(ipv, 5) == 2);
+  CHECK(mtp::find(ipv, 'x') == ipv.end());
+  CHECK(*mtp::find(std::as_const(ipv), 3L) == 3);
+}
+
+TEMPLATE_TEST_CASE("set operations", "[inplace_algorithm]", std::uint16_t, int, std::int64_t, double)
+{
+  auto rng = std::mt19937{ 7 };
+  check_set_operations<TestType>(rng);
+}
+
+TEST_CASE("set operations overflow", "[inplace_algorithm]")
+{
+  auto const a = inplace_vector<int, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 };
+  auto const b = inplace_vector<int, 8>{ 2, 4, 6, 8, 10 };
+
+  auto out = inplace_vector<int, 3>{};
+  CHECK(!mtp::try_set_intersection(a, b, out));
+  CHECK(out == inplace_vector<int, 3>{ 2, 4, 6 });
+
+  out.clear();
+  CHECK(!mtp::try_set_union(a, b, out));
+  CHECK(out == inplace_vector<int, 3>{ 1, 2, 3 });
+
+  auto const odd = inplace_vector<int, 8>{ 1, 3, 9 };
+  out.clear();
+  CHECK(mtp::try_set_intersection(a, odd, out));
+  CHECK(out == inplace_vector<int, 3>{ 1, 3 });
+
+  out.clear();
+  CHECK_THROWS_AS(mtp::merge(a, b, out), std::bad_alloc);
+
+  auto const words = inplace_vector<std::string, 4>{ "a", "c", "c" };
+  auto const more = inplace_vector<std::string, 4>{ "b", "c" };
+  auto strings = inplace_vector<std::string, 8>{};
+  mtp::set_union(words, more, strings);
+  CHECK(strings == inplace_vector<std::string, 8>{ "a", "b", "c", "c" });
+}
+
+TEST_CASE("set operations constexpr", "[inplace_algorithm]")
+{
+  constexpr auto merged = [] {
+    auto out = inplace_vector<int, 6>{};
+    mtp::merge(inplace_vector<int, 3>{ 1, 4, 6 }, inplace_vector<int, 3>{ 2, 4, 5 }, out);
+    return out;
+  }();
+  static_assert(merged == inplace_vector<int, 6>{ 1, 2, 4, 4, 5, 6 });
+}
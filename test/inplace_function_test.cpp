@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mtp/inplace_function.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_function;
+using mtp::inplace_vector;
+
+static_assert(mtp::is_trivially_relocatable_v<inplace_function<void()>>);
+static_assert(mtp::is_trivially_relocatable_v<inplace_vector<inplace_function<void()>, 4>>);
+static_assert(std::is_nothrow_move_constructible_v<inplace_function<int(int)>>);
+
+// accepts any nothrow movable target, and is no longer trivially relocatable itself
+template <typename Sig>
+using any_function = inplace_function<Sig, 48, alignof(std::max_align_t), false>;
+static_assert(!mtp::is_trivially_relocatable_v<any_function<void()>>);
+static_assert(std::is_nothrow_move_constructible_v<any_function<void()>>);
+
+struct counted
+{
+  int* copies;
+
+  counted(int* c) : copies{ c } {}
+  counted(counted const& other) : copies{ other.copies }
+  {
+    ++*copies;
+  }
+  ~counted() {}
+
+  auto
+  operator()(int x) const -> int
+  {
+    return x + *copies;
+  }
+};
+
+} // namespace
+
+template <>
+struct mtp::is_trivially_relocatable<counted> : std::true_type
+{};
+
+TEST_CASE("inplace_function invoke", "[inplace_function]")
+{
+  auto f = inplace_function<int(int)>{};
+  CHECK(!f);
+  CHECK(f == nullptr);
+  CHECK_THROWS_AS(f(1), std::bad_function_call);
+
+  auto const offset = 10;
+  f = [offset](int x) { return x + offset; };
+  CHECK(f);
+  CHECK(f(1) == 11);
+
+  auto big = std::array<int, 8>{ 1, 2, 3, 4, 5, 6, 7, 8 };
+  auto g = inplace_function<int(), sizeof(big)>{ [big]() { return big[7]; } };
+  CHECK(g() == 8);
+
+  auto counter = 0;
+  auto h = inplace_function<void()>{ [&counter]() mutable { ++counter; } };
+  h();
+  h();
+  CHECK(counter == 2);
+}
+
+TEST_CASE("inplace_function copy and relocation", "[inplace_function]")
+{
+  auto copies = 0;
+  auto f = inplace_function<int(int)>{ counted{ &copies } };
+  CHECK(copies == 1);
+
+  auto g = f;
+  CHECK(copies == 2);
+  CHECK(g(1) == 3);
+
+  auto h = std::move(g);
+  CHECK(copies == 2);
+  CHECK(!g);
+  CHECK(h(0) == 2);
+
+  swap(f, g);
+  CHECK(!f);
+  CHECK(g(0) == 2);
+}
+
+TEST_CASE("inplace_function task queue", "[inplace_function]")
+{
+  auto log = inplace_vector<int, 8>{};
+  auto queue = inplace_vector<inplace_function<void()>, 4>{};
+  for (auto i = 0; i < 4; ++i) {
+    queue.push_back([&log, i]() { log.push_back(i); });
+  }
+  CHECK_THROWS_AS(queue.push_back([]() {}), std::bad_alloc);
+
+  while (!queue.empty()) {
+    queue.front()();
+    queue.erase(queue.begin());
+  }
+  CHECK(log == inplace_vector<int, 8>{ 0, 1, 2, 3 });
+}
+
+TEST_CASE("inplace_function non trivially relocatable targets", "[inplace_function]")
+{
+  auto name = std::string(40, 'x');
+  auto f = any_function<std::size_t()>{ [name]() { return name.size(); } };
+  auto shared = std::make_shared<int>(7);
+  auto g = any_function<std::size_t()>{ [shared]() { return static_cast<std::size_t>(*shared); } };
+  CHECK(shared.use_count() == 2);
+
+  auto h = std::move(f);
+  CHECK(!f);
+  CHECK(h() == 40);
+  swap(g, h);
+  CHECK(g() == 40);
+  CHECK(h() == 7);
+
+  auto copy = h;
+  CHECK(shared.use_count() == 3);
+  copy = nullptr;
+  CHECK(shared.use_count() == 2);
+
+  // trivially relocatable targets still move as bytes
+  auto queue = inplace_vector<any_function<std::size_t()>, 4>{};
+  queue.push_back(std::move(g));
+  queue.push_back([]() { return std::size_t{ 1 }; });
+  queue.insert(queue.begin(), std::move(h));
+  CHECK(queue[0]() == 7);
+  CHECK(queue[1]() == 40);
+  CHECK(queue[2]() == 1);
+  queue.erase(queue.begin());
+  CHECK(queue[0]() == 40);
+  queue.clear();
+  CHECK(shared.use_count() == 1);
+}
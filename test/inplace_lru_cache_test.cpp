@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mtp/inplace_lru_cache.hpp>
+
+namespace {
+
+using mtp::inplace_lru_cache;
+
+static_assert(sizeof(inplace_lru_cache<int, int, 64>::link_type) == 1);
+
+template <typename Cache>
+auto
+recency(Cache const& cache)
+{
+  auto keys = std::vector<typename Cache::key_type>{};
+  cache.for_each([&](auto const& key, auto const&) { keys.push_back(key); });
+  return keys;
+}
+
+} // namespace
+
+TEST_CASE("inplace_lru_cache eviction", "[inplace_lru_cache]")
+{
+  auto cache = inplace_lru_cache<int, std::string, 3>{};
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  CHECK(recency(cache) == std::vector{ 3, 2, 1 });
+
+  CHECK(*cache.get(1) == "one");
+  CHECK(recency(cache) == std::vector{ 1, 3, 2 });
+
+  cache.put(4, "four");
+  CHECK(cache.size() == 3);
+  CHECK(!cache.contains(2));
+  CHECK(recency(cache) == std::vector{ 4, 1, 3 });
+
+  cache.put(3, "THREE");
+  CHECK(*cache.peek(3) == "THREE");
+  CHECK(recency(cache) == std::vector{ 3, 4, 1 });
+
+  CHECK(cache.erase(4));
+  CHECK(!cache.erase(4));
+  CHECK(recency(cache) == std::vector{ 3, 1 });
+  cache.put(5, "five");
+  cache.put(6, "six");
+  CHECK(recency(cache) == std::vector{ 6, 5, 3 });
+
+  // a throwing value leaves the entry that would have been evicted in place
+  struct poison
+  {
+    operator std::string() const { throw std::runtime_error("poison"); }
+  };
+  CHECK_THROWS_AS(cache.put(7, poison{}), std::runtime_error);
+  CHECK(recency(cache) == std::vector{ 6, 5, 3 });
+  CHECK(*cache.peek(3) == "THREE");
+}
+
+TEST_CASE("inplace_lru_cache memoization stats", "[inplace_lru_cache]")
+{
+  auto cache = inplace_lru_cache<std::uint32_t, int, 40>{};
+  auto calls = 0;
+  auto square = [&](std::uint32_t x) {
+    return cache.get_or_insert(x, [&]() {
+      ++calls;
+      return static_cast<int>(x * x);
+    });
+  };
+
+  for (auto round = 0; round < 2; ++round) {
+    for (auto x = 0u; x < 40; ++x) {
+      CHECK(square(x) == static_cast<int>(x * x));
+    }
+  }
+  CHECK(calls == 40);
+  CHECK(cache.misses() == 40);
+  CHECK(cache.hits() == 40);
+
+  CHECK(cache.get(1000) == nullptr);
+  CHECK(cache.misses() == 41);
+  cache.reset_stats();
+  CHECK(cache.hits() == 0);
+
+  cache.clear();
+  CHECK(cache.empty());
+  CHECK(!cache.contains(1));
+}
@@ -0,0 +1,270 @@
+#include <catch2/catch.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mtp/inplace_memory_resource.hpp>
+
+namespace {
+
+using mtp::inplace_memory_resource;
+
+// forwards to new/delete and counts the calls
+class counting_resource : public std::pmr::memory_resource
+{
+  auto
+  do_allocate(std::size_t bytes, std::size_t align) -> void* override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+
+  auto
+  do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override
+  {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+
+  [[nodiscard]] auto
+  do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+  {
+    return this == &other;
+  }
+
+public:
+  int allocations{ 0 };
+  int deallocations{ 0 };
+};
+
+// minimal lazily started coroutine returning an int
+struct task
+{
+  struct promise_type : mtp::promise_frame_allocator
+  {
+    int value{ 0 };
+
+    auto
+    get_return_object() -> task
+    {
+      return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+    auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    auto final_suspend() noexcept -> std::suspend_always { return {}; }
+    auto return_value(int v) noexcept -> void { value = v; }
+    auto unhandled_exception() -> void { throw; }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+
+  explicit task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+  task(task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+  ~task()
+  {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  auto
+  get() -> int
+  {
+    handle.resume();
+    return handle.promise().value;
+  }
+};
+
+// GCC 12 pairs the frame's (template) placement `operator new` with the usual `operator delete`
+// and reports a mismatch, although coroutines always free their frames with the usual form
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+template <typename R>
+auto
+add(std::allocator_arg_t, R&, int a, int b) -> task
+{
+  co_return a + b;
+}
+
+auto
+add(int a, int b) -> task
+{
+  co_return a + b;
+}
+
+struct multiplier
+{
+  int factor;
+
+  template <typename R>
+  auto
+  apply(std::allocator_arg_t, R&, int a) const -> task
+  {
+    co_return a * factor;
+  }
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic pop
+#endif
+
+} // namespace
+
+TEST_CASE("inplace_memory_resource serves pmr containers", "[inplace_memory_resource]")
+{
+  auto upstream = counting_resource{};
+  auto resource = inplace_memory_resource<1024>(&upstream);
+  CHECK(resource.capacity() == 1024);
+  CHECK(resource.upstream_resource() == &upstream);
+
+  {
+    auto vec = std::pmr::vector<int>(&resource);
+    vec.reserve(64);
+    for (auto i = 0; i < 64; ++i) {
+      vec.push_back(i);
+    }
+    CHECK(resource.owns(vec.data()));
+    CHECK(resource.used() == 64 * sizeof(int));
+
+    auto str = std::pmr::string(100, 'x', &resource);
+    CHECK(resource.owns(str.data()));
+
+    // the vector's block is not the last one, it is only reclaimed by release
+    vec = std::pmr::vector<int>(&resource);
+    CHECK(resource.used() > 64 * sizeof(int));
+  }
+  CHECK(resource.used() == 64 * sizeof(int));
+  CHECK(upstream.allocations == 0);
+
+  resource.release();
+  CHECK(resource.used() == 0);
+  CHECK(resource.remaining() == 1024);
+}
+
+TEST_CASE("inplace_memory_resource allocation", "[inplace_memory_resource]")
+{
+  SECTION("alignment and lifo rollback")
+  {
+    auto resource = inplace_memory_resource<256, 64>{};
+    auto const a = resource.allocate(1, 1);
+    auto const b = resource.allocate(8, 64); // padded to 64 bytes
+    CHECK(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    CHECK(resource.used() == 128);
+
+    resource.deallocate(a, 1, 1); // not the last block
+    CHECK(resource.used() == 128);
+    resource.deallocate(b, 8, 64);
+    CHECK(resource.used() == 64);
+
+    // stricter than the buffer alignment
+    auto const c = resource.allocate(16, 128);
+    CHECK(reinterpret_cast<std::uintptr_t>(c) % 128 == 0);
+    CHECK(resource.owns(c));
+  }
+
+  SECTION("fallback to upstream")
+  {
+    auto upstream = counting_resource{};
+    {
+      auto resource = inplace_memory_resource<64>(&upstream);
+      auto const a = resource.allocate(48);
+      auto const b = resource.allocate(32, 32);
+      CHECK(resource.owns(a));
+      CHECK(!resource.owns(b));
+      CHECK(reinterpret_cast<std::uintptr_t>(b) % 32 == 0);
+      CHECK(resource.upstream_bytes() == 32);
+      CHECK(upstream.allocations == 1);
+
+      resource.deallocate(b, 32, 32); // kept until release
+      CHECK(upstream.deallocations == 0);
+      static_cast<void>(resource.allocate(100));
+      CHECK(upstream.allocations == 2);
+
+      resource.release();
+      CHECK(upstream.deallocations == 2);
+      CHECK(resource.upstream_bytes() == 0);
+      static_cast<void>(resource.allocate(100));
+    }
+    // the destructor releases
+    CHECK(upstream.allocations == 3);
+    CHECK(upstream.deallocations == 3);
+  }
+
+  SECTION("no upstream")
+  {
+    auto resource = inplace_memory_resource<32>{};
+    static_cast<void>(resource.allocate(16));
+    CHECK_THROWS_AS(resource.allocate(32), std::bad_alloc);
+    CHECK(resource.used() == 16);
+
+    auto vec = std::pmr::vector<int>(&resource);
+    CHECK_THROWS_AS(vec.resize(16), std::bad_alloc);
+    CHECK(vec.empty());
+  }
+
+  SECTION("equality")
+  {
+    auto a = inplace_memory_resource<16>{};
+    auto b = inplace_memory_resource<16>{};
+    CHECK(a.is_equal(a));
+    CHECK(!a.is_equal(b));
+  }
+}
+
+TEST_CASE("promise_frame_allocator", "[inplace_memory_resource]")
+{
+  auto upstream = counting_resource{};
+  auto resource = inplace_memory_resource<4096>(&upstream);
+
+  SECTION("frames from the resource")
+  {
+    {
+      auto t = add(std::allocator_arg, resource, 2, 3);
+      CHECK(resource.used() > 0);
+      CHECK(resource.owns(t.handle.address()));
+      CHECK(t.get() == 5);
+    }
+    // the only frame was the last block
+    CHECK(resource.used() == 0);
+
+    {
+      auto const m = multiplier{ 4 };
+      auto t = m.apply(std::allocator_arg, resource, 5);
+      CHECK(resource.owns(t.handle.address()));
+      CHECK(t.get() == 20);
+    }
+    CHECK(resource.used() == 0);
+
+    // frames that outgrow the buffer come from upstream, nested ones stay lifo
+    auto frames = std::vector<task>{};
+    for (auto i = 0; i < 128; ++i) {
+      frames.push_back(add(std::allocator_arg, resource, i, 1));
+    }
+    CHECK(upstream.allocations > 0);
+    for (auto i = 0; auto& t : frames) {
+      CHECK(t.get() == i + 1);
+      ++i;
+    }
+    while (!frames.empty()) {
+      frames.pop_back();
+    }
+    CHECK(resource.used() == 0);
+  }
+
+  SECTION("frames from the default resource")
+  {
+    auto t = add(2, 3);
+    CHECK(!resource.owns(t.handle.address()));
+    CHECK(t.get() == 5);
+    CHECK(resource.used() == 0);
+  }
+}
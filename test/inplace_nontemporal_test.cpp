@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <mtp/inplace_nontemporal.hpp>
+#include <mtp/inplace_vector.hpp>
+
+using mtp::inplace_vector;
+
+TEST_CASE("nontemporal copies", "[inplace_nontemporal]")
+{
+  using buffer = inplace_vector<std::byte, 65536>;
+  using mtp::nontemporal;
+
+  auto src = std::vector<std::byte>(65536 + 64);
+  for (auto i = std::size_t{ 0 }; i < src.size(); ++i) {
+    src[i] = static_cast<std::byte>(i * 31 + 7);
+  }
+
+  // every head and tail length around the 16 byte store width
+  auto dst = buffer{};
+  for (auto offset = std::size_t{ 0 }; offset < 17; ++offset) {
+    mtp::assign(nontemporal, dst, src.begin() + offset, src.begin() + 1000 + offset);
+    CHECK(std::equal(dst.begin(), dst.end(), src.begin() + offset, src.begin() + 1000 + offset));
+    mtp::append_range(nontemporal, dst,
+                      std::vector<std::byte>(src.begin(), src.begin() + offset));
+    CHECK(dst.size() == 1000 + offset);
+    CHECK(std::equal(dst.begin() + 1000, dst.end(), src.begin()));
+  }
+
+  mtp::assign_range(nontemporal, dst, std::vector<std::byte>(src.begin(), src.begin() + 65536));
+  CHECK(std::equal(dst.begin(), dst.end(), src.begin()));
+  CHECK_THROWS_AS(mtp::append_range(nontemporal, dst, std::vector<std::byte>(1)),
+                  std::bad_alloc);
+  CHECK_THROWS_AS(mtp::assign(nontemporal, dst, src.begin(), src.end()), std::bad_alloc);
+  CHECK(dst.size() == 65536);
+
+  mtp::assign_range(nontemporal, dst, std::vector<std::byte>{});
+  CHECK(dst.empty());
+}
+
+TEST_CASE("nontemporal copies in constant expressions", "[inplace_nontemporal]")
+{
+  using ints = inplace_vector<int, 4>;
+
+  constexpr auto streamed = []() {
+    auto const src = std::array{ 1, 2, 3 };
+    auto v = ints{ 0 };
+    mtp::append_range(mtp::nontemporal, v, src);
+    return v;
+  }();
+  static_assert(streamed == ints{ 0, 1, 2, 3 });
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <mtp/inplace_parallel.hpp>
+
+namespace {
+
+using mtp::batch_pool;
+using mtp::inplace_vector;
+
+// an L1d of items, but at least 8 chunks per thread and never more chunks than the deques hold
+static_assert(mtp::detail::ipv::parallel::grain_size(1 << 16, 64, 1) == 512);
+static_assert(mtp::detail::ipv::parallel::grain_size(1000, 64, 4) == 31);
+static_assert(mtp::detail::ipv::parallel::grain_size(10, 64, 4) == 1);
+static_assert(mtp::detail::ipv::parallel::grain_size(1 << 24, 1024, 2) == 8192);
+
+auto
+make_batches(std::size_t count) -> std::vector<inplace_vector<int, 16>>
+{
+  auto batches = std::vector<inplace_vector<int, 16>>(count);
+  auto seed = 12345u;
+  for (auto& ipv : batches) {
+    seed = seed * 1103515245u + 12345u;
+    auto const size = (seed >> 16) % 17;
+    for (auto i = 0u; i < size; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      ipv.push_back(static_cast<int>((seed >> 16) % 8));
+    }
+  }
+  return batches;
+}
+
+} // namespace
+
+TEST_CASE("batch_pool covers every index once", "[inplace_parallel]")
+{
+  auto pool = batch_pool(4);
+  CHECK(pool.threads() == 4);
+
+  for (auto const count : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 1000 },
+                            std::size_t{ 100'000 } }) {
+    // Catch assertions are not thread-safe, the body only counts
+    auto hits = std::vector<std::atomic<int>>(count);
+    auto empty_ranges = std::atomic<int>{ 0 };
+    auto const stats = pool.run(count, 7, [&](std::size_t first, std::size_t last) {
+      empty_ranges.fetch_add(first >= last ? 1 : 0, std::memory_order_relaxed);
+      for (auto i = first; i < last; ++i) {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+    CHECK(std::all_of(hits.begin(), hits.end(), [](auto const& hit) { return hit.load() == 1; }));
+    CHECK(empty_ranges.load() == 0);
+    CHECK(stats.items == count);
+    CHECK(stats.threads == 4);
+    if (count > 0) {
+      // the grain is raised when 7 would overflow the deques
+      CHECK(stats.grain >= 7);
+      CHECK(stats.chunks == (count + stats.grain - 1) / stats.grain);
+    }
+  }
+}
+
+TEST_CASE("batch_pool rethrows the first exception", "[inplace_parallel]")
+{
+  auto pool = batch_pool(3);
+  auto const body = [](std::size_t first, std::size_t) {
+    if (first == 500) {
+      throw std::runtime_error("chunk 500");
+    }
+  };
+  CHECK_THROWS_AS(pool.run(1000, 1, body), std::runtime_error);
+
+  // the pool is usable afterwards
+  auto sum = std::atomic<std::size_t>{ 0 };
+  static_cast<void>(pool.run(1000, 10, [&](std::size_t first, std::size_t last) {
+    sum.fetch_add(last - first, std::memory_order_relaxed);
+  }));
+  CHECK(sum.load() == 1000);
+}
+
+TEST_CASE("batch algorithms", "[inplace_parallel]")
+{
+  auto pool = batch_pool(4);
+  auto const original = make_batches(5000);
+
+  SECTION("sort_each")
+  {
+    auto batches = original;
+    auto const stats = mtp::sort_each(pool, batches);
+    CHECK(stats.items == batches.size());
+    for (auto i = std::size_t{ 0 }; i < batches.size(); ++i) {
+      auto expected = original[i];
+      std::sort(expected.begin(), expected.end());
+      CHECK(batches[i] == expected);
+    }
+
+    static_cast<void>(mtp::sort_each(pool, batches, std::greater<>{}));
+    CHECK(std::all_of(batches.begin(), batches.end(), [](auto const& ipv) {
+      return std::is_sorted(ipv.begin(), ipv.end(), std::greater<>{});
+    }));
+  }
+
+  SECTION("dedupe_each")
+  {
+    auto batches = original;
+    static_cast<void>(mtp::dedupe_each(pool, batches));
+    for (auto i = std::size_t{ 0 }; i < batches.size(); ++i) {
+      auto expected = original[i];
+      std::sort(expected.begin(), expected.end());
+      expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+      CHECK(batches[i] == expected);
+    }
+  }
+
+  SECTION("filter_each")
+  {
+    auto batches = original;
+    static_cast<void>(mtp::filter_each(pool, batches, [](int value) { return value % 2 == 0; }));
+    for (auto i = std::size_t{ 0 }; i < batches.size(); ++i) {
+      auto expected = original[i];
+      expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                    [](int value) { return value % 2 != 0; }),
+                     expected.end());
+      CHECK(batches[i] == expected);
+    }
+  }
+
+  SECTION("transform_each")
+  {
+    auto batches = original;
+    static_cast<void>(mtp::transform_each(pool, batches, [](int value) { return value * 3; }));
+    for (auto i = std::size_t{ 0 }; i < batches.size(); ++i) {
+      CHECK(batches[i].size() == original[i].size());
+      CHECK(std::equal(batches[i].begin(), batches[i].end(), original[i].begin(),
+                       [](int after, int before) { return after == before * 3; }));
+    }
+  }
+
+  SECTION("for_each_batch over a subrange")
+  {
+    auto batches = original;
+    auto const stats = mtp::for_each_batch(pool, std::span(batches).subspan(1000, 10),
+                                           [](auto& ipv) { ipv.clear(); });
+    CHECK(stats.items == 10);
+    for (auto i = std::size_t{ 0 }; i < batches.size(); ++i) {
+      CHECK(batches[i].empty() == (i >= 1000 && i < 1010 ? true : original[i].empty()));
+    }
+  }
+}
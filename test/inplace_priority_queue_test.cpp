@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+#include <mtp/inplace_priority_queue.hpp>
+
+namespace {
+
+using mtp::inplace_priority_queue;
+
+template <typename Q>
+auto
+drain(Q& q) -> std::vector<int>
+{
+  auto out = std::vector<int>{};
+  while (!q.empty()) {
+    out.push_back(q.extract_top());
+  }
+  return out;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE_SIG("inplace_priority_queue ordering", "[inplace_priority_queue]",
+                       ((std::size_t Arity), Arity), 2, 3, 4, 8)
+{
+  auto const input = std::array{ 5, 1, 9, 3, 7, 2, 8, 6, 4, 0, 9, 3 };
+
+  auto q = inplace_priority_queue<int, 16, std::less<int>, Arity>{};
+  for (auto const v : input) {
+    q.push(v);
+  }
+  CHECK(q.top() == 9);
+
+  auto expected = std::vector<int>(input.begin(), input.end());
+  std::sort(expected.begin(), expected.end(), std::greater<>{});
+  CHECK(drain(q) == expected);
+
+  auto h = inplace_priority_queue<int, 16, std::greater<int>, Arity>{};
+  h.heapify(input);
+  std::sort(expected.begin(), expected.end());
+  CHECK(drain(h) == expected);
+}
+
+TEST_CASE("inplace_priority_queue bounded", "[inplace_priority_queue]")
+{
+  auto q = inplace_priority_queue<int, 4>{};
+  for (auto const v : { 10, 3, 7, 1, 9, 2, 8, 0 }) {
+    q.push_bounded(v);
+  }
+  CHECK(q.full());
+  CHECK(!q.push_bounded(5));
+  CHECK(drain(q) == std::vector{ 3, 2, 1, 0 });
+
+  CHECK(q.try_push(1));
+  CHECK_THROWS_AS([&]() {
+    for (auto i = 0; i < 4; ++i) {
+      q.push(i);
+    }
+  }(), std::bad_alloc);
+  CHECK(!q.try_push(1));
+}
+
+TEST_CASE("inplace_priority_queue heapify overflow", "[inplace_priority_queue]")
+{
+  auto q = inplace_priority_queue<int, 4>{};
+  q.push(1);
+  CHECK_THROWS_AS(q.heapify(std::vector{ 2, 3, 4, 5, 6 }), std::bad_alloc);
+
+  // whatever was appended is still a heap
+  auto const top = q.top();
+  auto const drained = drain(q);
+  CHECK(!drained.empty());
+  CHECK(drained.front() == top);
+  CHECK(std::is_sorted(drained.begin(), drained.end(), std::greater<>{}));
+}
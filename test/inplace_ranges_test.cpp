@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <forward_list>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mtp/inplace_ranges.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+using mtp::overflow;
+
+static_assert(std::ranges::input_range<mtp::batched_view<std::views::all_t<std::vector<int>&>, 4>>);
+static_assert(std::ranges::view<mtp::batched_view<std::views::all_t<std::vector<int>&>, 4>>);
+
+template <typename R>
+auto
+sizes(R&& batches) -> std::vector<std::size_t>
+{
+  auto result = std::vector<std::size_t>{};
+  for (auto const& batch : batches) {
+    result.push_back(batch.size());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("views::batched", "[inplace_ranges]")
+{
+  SECTION("contiguous source")
+  {
+    auto const values = std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    CHECK(sizes(values | mtp::views::batched<4>) == std::vector<std::size_t>{ 4, 4, 2 });
+    CHECK(sizes(mtp::views::batched<5>(values)) == std::vector<std::size_t>{ 5, 5 });
+    CHECK(sizes(std::vector<int>{} | mtp::views::batched<4>).empty());
+
+    auto joined = std::vector<int>{};
+    for (auto const& batch : values | mtp::views::batched<3>) {
+      static_assert(std::is_same_v<decltype(batch), inplace_vector<int, 3> const&>);
+      joined.insert(joined.end(), batch.begin(), batch.end());
+    }
+    CHECK(joined == values);
+  }
+
+  SECTION("single pass source")
+  {
+    auto stream = std::istringstream("1 2 3 4 5 6 7");
+    auto batches = std::views::istream<int>(stream) | mtp::views::batched<3>;
+    auto it = batches.begin();
+    CHECK(*it == inplace_vector<int, 3>{ 1, 2, 3 });
+    ++it;
+    CHECK(*it == inplace_vector<int, 3>{ 4, 5, 6 });
+    ++it;
+    CHECK(*it == inplace_vector<int, 3>{ 7 });
+    ++it;
+    CHECK(it == batches.end());
+  }
+
+  SECTION("composes with std views")
+  {
+    auto evens = std::views::iota(0, 20) |
+                 std::views::filter([](int value) { return value % 2 == 0; }) |
+                 mtp::views::batched<4>;
+    auto total = 0;
+    for (auto const& batch : evens) {
+      for (auto const value : batch) {
+        total += value;
+      }
+    }
+    CHECK(total == 90);
+  }
+
+  SECTION("lvalue sources are copied, rvalue containers moved")
+  {
+    auto words = std::vector<std::string>{ "alpha", "beta", "gamma" };
+    for (auto&& batch : words | mtp::views::batched<2>) {
+      static_cast<void>(batch);
+    }
+    CHECK(words == std::vector<std::string>{ "alpha", "beta", "gamma" });
+
+    auto owned = std::vector<std::unique_ptr<int>>{};
+    owned.push_back(std::make_unique<int>(1));
+    owned.push_back(std::make_unique<int>(2));
+    owned.push_back(std::make_unique<int>(3));
+    auto taken = std::vector<std::unique_ptr<int>>{};
+    for (auto& batch : std::move(owned) | mtp::views::batched<2>) {
+      for (auto& p : batch) {
+        taken.push_back(std::move(p));
+      }
+    }
+    REQUIRE(taken.size() == 3);
+    CHECK(*taken[2] == 3);
+  }
+}
+
+TEST_CASE("to_inplace", "[inplace_ranges]")
+{
+  auto const values = std::array{ 1, 2, 3, 4, 5 };
+
+  auto const all = mtp::to_inplace<8>(values);
+  static_assert(std::is_same_v<decltype(all), inplace_vector<int, 8> const>);
+  CHECK(all == inplace_vector<int, 8>{ 1, 2, 3, 4, 5 });
+  CHECK((values | mtp::to_inplace<5>()) == inplace_vector<int, 5>{ 1, 2, 3, 4, 5 });
+  CHECK(mtp::to_inplace<5, overflow::unchecked>(values).size() == 5);
+
+  SECTION("overflow")
+  {
+    CHECK_THROWS_AS(mtp::to_inplace<4>(values), std::bad_alloc);
+    CHECK(mtp::to_inplace<3, overflow::truncate>(values) == inplace_vector<int, 3>{ 1, 2, 3 });
+
+    // not sized: the overflow is found by the element after the capacity
+    auto const list = std::forward_list<int>{ 1, 2, 3, 4, 5 };
+    CHECK_THROWS_AS(mtp::to_inplace<4>(list), std::bad_alloc);
+    CHECK(mtp::to_inplace<5>(list) == inplace_vector<int, 5>{ 1, 2, 3, 4, 5 });
+    CHECK((list | mtp::to_inplace<2, overflow::truncate>()) == inplace_vector<int, 2>{ 1, 2 });
+  }
+
+  SECTION("single pass source")
+  {
+    auto stream = std::istringstream("1 2 3 4");
+    auto const ipv = mtp::to_inplace<3, overflow::truncate>(std::views::istream<int>(stream));
+    CHECK(ipv == inplace_vector<int, 3>{ 1, 2, 3 });
+  }
+
+  SECTION("rvalue containers are moved from")
+  {
+    auto owned = std::vector<std::unique_ptr<int>>{};
+    owned.push_back(std::make_unique<int>(7));
+    auto const ipv = mtp::to_inplace<2>(std::move(owned));
+    REQUIRE(ipv.size() == 1);
+    CHECK(*ipv[0] == 7);
+  }
+}
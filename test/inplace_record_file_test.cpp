@@ -0,0 +1,154 @@
+#include <catch2/catch.hpp>
+
+#if __has_include(<sys/mman.h>)
+
+#  include <algorithm>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstdio>
+#  include <cstring>
+#  include <filesystem>
+#  include <fstream>
+#  include <memory>
+#  include <new>
+#  include <stdexcept>
+#  include <span>
+#  include <string>
+#  include <system_error>
+#  include <vector>
+
+#  include <mtp/inplace_record_file.hpp>
+#  include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+using ids = inplace_vector<std::uint32_t, 6>;
+
+struct temp_file
+{
+  std::string path;
+
+  explicit temp_file(char const* name)
+      : path((std::filesystem::temp_directory_path() / name).string())
+  {
+    std::filesystem::remove(path);
+  }
+
+  ~temp_file()
+  {
+    std::filesystem::remove(path);
+  }
+};
+
+} // namespace
+
+TEST_CASE("record file round trip and append", "[inplace_record_file]")
+{
+  auto const file = temp_file("mtp_record_file_test.bin");
+  auto const records = std::vector<ids>{ {}, { 1, 2, 3 }, { 4, 5, 6, 7, 8, 9 }, { 10 } };
+
+  {
+    auto writer = mtp::record_file_writer<std::uint32_t, 6>(file.path.c_str());
+    writer.append(records[0]);
+    writer.append(std::span(records).subspan(1, 2));
+    CHECK(writer.size() == 3);
+    writer.close();
+  }
+
+  {
+    auto const reader = mtp::record_file_reader<std::uint32_t, 6>(file.path.c_str());
+    REQUIRE(reader);
+    REQUIRE(reader.size() == 3);
+    CHECK(reader[1] == records[1]);
+    CHECK(std::equal(reader.begin(), reader.end(), records.begin()));
+  }
+
+  // a partial trailing record is ignored by readers and cut off by appending writers
+  {
+    auto out = std::ofstream(file.path, std::ios::binary | std::ios::app);
+    out.write("xyz", 3);
+  }
+  CHECK(mtp::record_file_reader<std::uint32_t, 6>(file.path.c_str()).size() == 3);
+
+  {
+    auto writer =
+        mtp::record_file_writer<std::uint32_t, 6>(file.path.c_str(), mtp::record_file_mode::append);
+    CHECK(writer.size() == 3);
+    writer.append(records[3]);
+  }
+
+  auto const reader = mtp::record_file_reader<std::uint32_t, 6>(file.path.c_str());
+  CHECK(std::equal(reader.begin(), reader.end(), records.begin(), records.end()));
+  std::span<ids const> const view = reader.records();
+  CHECK(view.back() == records[3]);
+
+  // unused elements are zeroed in the file
+  auto const& padded = reader[3];
+  CHECK(std::all_of(padded.data() + 1, padded.data() + 6, [](auto v) { return v == 0; }));
+}
+
+TEST_CASE("record file zeroes the record padding", "[inplace_record_file]")
+{
+  using wide = inplace_vector<std::uint64_t, 3>;
+  static_assert(sizeof(wide) > 3 * sizeof(std::uint64_t) + 1);
+  auto const file = temp_file("mtp_record_file_padding_test.bin");
+
+  {
+    // a record whose padding bytes are not zero
+    alignas(wide) std::byte raw[sizeof(wide)];
+    std::memset(raw, 0xab, sizeof(raw));
+    auto const record = ::new (raw) wide{ 7 };
+    auto writer = mtp::record_file_writer<std::uint64_t, 3>(file.path.c_str());
+    writer.append(*record);
+  }
+
+  auto const reader = mtp::record_file_reader<std::uint64_t, 3>(file.path.c_str());
+  REQUIRE(reader.size() == 1);
+  CHECK(reader[0] == wide{ 7 });
+  auto const bytes = reinterpret_cast<std::byte const*>(std::addressof(reader[0]));
+  auto const tail = 3 * sizeof(std::uint64_t) + 1;
+  CHECK(std::all_of(bytes + tail, bytes + sizeof(wide), [](auto b) { return b == std::byte{}; }));
+}
+
+TEST_CASE("record file validation", "[inplace_record_file]")
+{
+  auto const file = temp_file("mtp_record_file_validation.bin");
+  {
+    auto writer = mtp::record_file_writer<std::uint32_t, 6>(file.path.c_str());
+    writer.append(ids{ 1, 2 });
+  }
+
+  // other capacity, other element type
+  CHECK_THROWS_AS((mtp::record_file_reader<std::uint32_t, 7>(file.path.c_str())),
+                  std::runtime_error);
+  CHECK_THROWS_AS((mtp::record_file_reader<std::int32_t, 6>(file.path.c_str())),
+                  std::runtime_error);
+  CHECK_THROWS_AS((mtp::record_file_writer<float, 6>(file.path.c_str(),
+                                                     mtp::record_file_mode::append)),
+                  std::runtime_error);
+  CHECK_THROWS_AS((mtp::record_file_reader<std::uint32_t, 6>("/nonexistent/mtp/records.bin")),
+                  std::system_error);
+
+  // corrupt size field: the record's only byte outside the element array that holds its size
+  {
+    auto const record = ids{ 1, 2 };
+    auto const bytes = reinterpret_cast<unsigned char const*>(&record);
+    auto const first = static_cast<std::size_t>(
+        reinterpret_cast<unsigned char const*>(record.data()) - bytes);
+    auto const last = first + sizeof(std::uint32_t) * record.capacity();
+    auto pos = std::size_t{ 0 };
+    while ((pos >= first && pos < last) || bytes[pos] != 2) {
+      ++pos;
+    }
+    auto f = std::fopen(file.path.c_str(), "r+b");
+    REQUIRE(f);
+    std::fseek(f, static_cast<long>(64 + pos), SEEK_SET);
+    std::fputc(0x7f, f);
+    std::fclose(f);
+  }
+  CHECK_THROWS_AS((mtp::record_file_reader<std::uint32_t, 6>(file.path.c_str())),
+                  std::runtime_error);
+}
+
+#endif
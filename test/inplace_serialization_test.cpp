@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <mtp/inplace_serialization.hpp>
+#include <mtp/inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+struct sample
+{
+  std::uint16_t id;
+  float value;
+
+  friend auto
+  operator==(sample const&, sample const&) -> bool = default;
+};
+
+// trivially copyable, but not default constructible
+struct point
+{
+  std::int32_t x;
+  std::int32_t y;
+
+  constexpr point(std::int32_t px, std::int32_t py) noexcept : x(px), y(py) {}
+
+  friend auto
+  operator==(point const&, point const&) -> bool = default;
+};
+
+static_assert(std::is_trivially_copyable_v<point> && !std::is_default_constructible_v<point>);
+
+static_assert(sizeof(mtp::serialized_header<char>) == 8);
+static_assert(sizeof(mtp::serialized_header<long double>) == alignof(long double));
+
+} // namespace
+
+TEST_CASE("serialization round trip", "[inplace_serialization]")
+{
+  auto const ipv = inplace_vector<sample, 8>{ { 1, 0.5f }, { 2, 1.5f }, { 3, -2.0f } };
+  CHECK(mtp::serialized_size(ipv) == 8 + 3 * sizeof(sample));
+
+  alignas(std::uint64_t) std::byte buffer[128];
+  auto const end = mtp::serialize(ipv, buffer);
+  CHECK(end == buffer + mtp::serialized_size(ipv));
+
+  auto const view = mtp::serialized_view<sample, 8>(std::span(buffer));
+  REQUIRE(view);
+  CHECK(view.size() == 3);
+  CHECK(view.data() == reinterpret_cast<sample const*>(buffer + 8));
+  CHECK(view[1] == sample{ 2, 1.5f });
+  CHECK(view.serialized_size() == mtp::serialized_size(ipv));
+  CHECK(view.to_inplace_vector() == ipv);
+
+  // any capacity that fits the size reads it
+  CHECK(mtp::deserialize<sample, 3>(buffer) == inplace_vector<sample, 3>(ipv.begin(), ipv.end()));
+  CHECK(!mtp::serialized_view<sample, 2>(std::span(buffer)));
+  CHECK_THROWS_AS((mtp::deserialize<sample, 2>(buffer)), std::length_error);
+
+  // truncated records are rejected, the destination is left untouched
+  auto out = inplace_vector<sample, 8>{ { 9, 9.0f } };
+  CHECK(!mtp::try_deserialize(std::span(buffer, end - 1), out));
+  CHECK(out.size() == 1);
+  CHECK(mtp::try_deserialize(std::span(buffer, end), out) == end);
+  CHECK(out == ipv);
+
+  CHECK(!mtp::try_serialize(ipv, std::span(buffer, 8 + 2 * sizeof(sample))));
+  CHECK_THROWS_AS(mtp::serialize(ipv, std::span(buffer, 8)), std::length_error);
+}
+
+TEST_CASE("serialization without default construction", "[inplace_serialization]")
+{
+  auto const ipv = inplace_vector<point, 4>{ point(1, 2), point(3, 4) };
+
+  alignas(std::uint64_t) std::byte buffer[64 + 1];
+  auto const end = mtp::serialize(ipv, buffer);
+  CHECK(mtp::deserialize<point, 4>(buffer) == ipv);
+
+  // the misaligned copy goes straight into the storage
+  std::memmove(buffer + 1, buffer, static_cast<std::size_t>(end - buffer));
+  auto out = inplace_vector<point, 4>{ point(5, 6) };
+  CHECK(mtp::try_deserialize(std::span(buffer + 1, end + 1), out) == end + 1);
+  CHECK(out == ipv);
+}
+
+TEST_CASE("serialization of a stream of records", "[inplace_serialization]")
+{
+  using ints = inplace_vector<std::uint32_t, 16>;
+  auto const records = std::vector<ints>{ {}, { 1 }, { 1, 2, 3, 4, 5 }, { 7, 7 } };
+
+  auto buffer = std::vector<std::uint64_t>(64);
+  auto const bytes = std::as_writable_bytes(std::span(buffer));
+  auto pos = bytes.data();
+  for (auto const& r : records) {
+    pos = mtp::serialize(r, std::span(pos, bytes.data() + bytes.size()));
+  }
+
+  // the read side steps from record to record without copying (records stay 4-byte aligned)
+  auto rest = std::span<std::byte const>(bytes.data(), pos);
+  for (auto const& r : records) {
+    auto const view = mtp::serialized_view<std::uint32_t, 16>(rest);
+    REQUIRE(view);
+    CHECK(std::equal(view.begin(), view.end(), r.begin(), r.end()));
+    rest = rest.subspan(view.serialized_size());
+  }
+  CHECK(rest.empty());
+
+  // misaligned payloads are rejected by the view but still copied by try_deserialize
+  auto shifted = std::vector<std::byte>(bytes.begin(), bytes.end());
+  shifted.insert(shifted.begin(), std::byte{ 0 });
+  auto const misaligned = std::span<std::byte const>(shifted).subspan(1);
+  if (reinterpret_cast<std::uintptr_t>(misaligned.data() + 8) % alignof(std::uint32_t) != 0) {
+    CHECK(!mtp::serialized_view<std::uint32_t, 16>(misaligned.subspan(8)));
+  }
+  auto out = ints{};
+  auto const next = mtp::try_deserialize(misaligned.subspan(8), out);
+  REQUIRE(next);
+  CHECK(out == records[1]);
+
+  // oversized size prefix
+  auto const huge = std::uint64_t{ 17 };
+  std::memcpy(bytes.data(), &huge, sizeof(huge));
+  CHECK(!mtp::serialized_view<std::uint32_t, 16>(std::span<std::byte const>(bytes)));
+}
+
+#if __has_include(<sys/uio.h>)
+TEST_CASE("serialization iovecs", "[inplace_serialization]")
+{
+  auto const ipv = inplace_vector<std::uint16_t, 4>{ 1, 2, 3 };
+  auto const header = mtp::serialize_header(ipv);
+  auto const iov = mtp::to_iovecs(header, ipv);
+  CHECK(iov[0].iov_len == 8);
+  CHECK(iov[1].iov_base == ipv.data());
+  CHECK(iov[1].iov_len == 3 * sizeof(std::uint16_t));
+
+  auto size = std::uint64_t{ 0 };
+  std::memcpy(&size, iov[0].iov_base, sizeof(size));
+  CHECK(size == 3);
+}
+#endif
@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include <mtp/inplace_slot_map.hpp>
+
+namespace {
+
+using mtp::inplace_slot_map;
+
+static_assert(sizeof(inplace_slot_map<int, 16>::index_type) == 1);
+
+} // namespace
+
+TEST_CASE("inplace_slot_map insert and erase", "[inplace_slot_map]")
+{
+  auto map = inplace_slot_map<std::string, 4>{};
+  auto const a = map.insert("a");
+  auto const b = map.insert("b");
+  auto const c = map.emplace(1, 'c');
+  CHECK(map.size() == 3);
+  CHECK(map[a] == "a");
+  CHECK(*map.get(b) == "b");
+  CHECK(map.at(c) == "c");
+
+  CHECK(map.erase(a));
+  CHECK(!map.erase(a));
+  CHECK(!map.contains(a));
+  CHECK(map.get(a) == nullptr);
+  CHECK_THROWS_AS(map.at(a), std::out_of_range);
+
+  // dense storage stays packed, remaining handles still resolve
+  CHECK(map.size() == 2);
+  CHECK(map[b] == "b");
+  CHECK(map[c] == "c");
+  auto const expected = std::array<std::string, 2>{ "b", "c" };
+  CHECK(std::is_permutation(map.begin(), map.end(), expected.begin(), expected.end()));
+
+  // freed slot is reused with a new generation
+  auto const d = map.insert("d");
+  CHECK(d.index == a.index);
+  CHECK(d != a);
+  CHECK(!map.contains(a));
+  CHECK(map[d] == "d");
+}
+
+TEST_CASE("inplace_slot_map capacity", "[inplace_slot_map]")
+{
+  auto map = inplace_slot_map<int, 2>{};
+  CHECK(map.try_emplace(1));
+  CHECK(map.try_emplace(2));
+  CHECK(!map.try_emplace(3));
+  CHECK_THROWS_AS(map.insert(3), std::bad_alloc);
+  CHECK(!map.contains(decltype(map)::handle{}));
+
+  auto const h = map.handle_at(1);
+  CHECK(map[h] == 2);
+
+  map.clear();
+  CHECK(map.empty());
+  CHECK(!map.contains(h));
+  CHECK(map.try_emplace(4));
+}
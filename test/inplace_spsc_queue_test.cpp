@@ -0,0 +1,159 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mtp/inplace_spsc_queue.hpp>
+
+namespace {
+
+using mtp::inplace_spsc_queue;
+
+// head and tail must not share a cache line
+static_assert(sizeof(inplace_spsc_queue<std::uint8_t, 8>) >= 3 * 64);
+
+// counts live objects, copies of a `poisoned` one throw
+struct counted
+{
+  static inline int live = 0;
+  bool poisoned = false;
+
+  counted() { ++live; }
+  explicit counted(bool p) : poisoned(p) { ++live; }
+  counted(counted const& other) : poisoned(other.poisoned)
+  {
+    if (poisoned) {
+      throw std::runtime_error("poisoned");
+    }
+    ++live;
+  }
+  auto operator=(counted const&) -> counted& = default;
+  ~counted() { --live; }
+};
+
+} // namespace
+
+TEST_CASE("inplace_spsc_queue single thread", "[inplace_spsc_queue]")
+{
+  auto q = inplace_spsc_queue<std::string, 4>{};
+  CHECK(q.empty());
+  CHECK(q.front() == nullptr);
+
+  CHECK(q.try_push("a"));
+  CHECK(q.try_emplace(3, 'b'));
+  CHECK(q.try_push(std::string("c")));
+  CHECK(q.try_push("d"));
+  CHECK(!q.try_push("e"));
+  CHECK(q.size() == 4);
+
+  REQUIRE(q.front());
+  CHECK(*q.front() == "a");
+  q.pop();
+
+  auto out = std::string{};
+  CHECK(q.try_pop(out));
+  CHECK(out == "bbb");
+
+  // wraps around the ring, the rest is destroyed with the queue
+  CHECK(q.try_push("e"));
+  CHECK(q.try_push("f"));
+  CHECK(!q.try_push("g"));
+
+  auto batch = std::array<std::string, 3>{};
+  CHECK(q.pop_batch(batch) == 3);
+  CHECK(batch == std::array<std::string, 3>{ "c", "d", "e" });
+  CHECK(q.size() == 1);
+}
+
+TEST_CASE("inplace_spsc_queue batches", "[inplace_spsc_queue]")
+{
+  auto q = inplace_spsc_queue<int, 8>{};
+  auto const values = std::array{ 1, 2, 3, 4, 5, 6 };
+  auto out = std::array<int, 8>{};
+
+  CHECK(q.push_batch(values) == 6);
+  CHECK(q.pop_batch(std::span(out).first(4)) == 4);
+  CHECK(out[3] == 4);
+
+  // 6 more only have room for 6, split across the end of the ring
+  CHECK(q.push_batch(values) == 6);
+  CHECK(q.push_batch(values) == 0);
+  CHECK(q.pop_batch(out) == 8);
+  CHECK(out == std::array{ 5, 6, 1, 2, 3, 4, 5, 6 });
+  CHECK(q.pop_batch(out) == 0);
+
+  // move-only elements are moved out slot by slot
+  auto owners = inplace_spsc_queue<std::unique_ptr<int>, 4>{};
+  CHECK(owners.try_push(std::make_unique<int>(7)));
+  auto popped = std::array<std::unique_ptr<int>, 2>{};
+  CHECK(owners.pop_batch(popped) == 1);
+  REQUIRE(popped[0]);
+  CHECK(*popped[0] == 7);
+}
+
+TEST_CASE("inplace_spsc_queue batch copy throws", "[inplace_spsc_queue]")
+{
+  {
+    auto q = inplace_spsc_queue<counted, 4>{};
+    auto const two = std::array<counted, 2>{};
+    auto const values = std::array{ counted{}, counted{}, counted{ true } };
+    CHECK(q.push_batch(two) == 2);
+    auto out = std::array<counted, 2>{};
+    CHECK(q.pop_batch(out) == 2);
+
+    // the batch wraps around after two slots, the wrapped run throws
+    CHECK_THROWS_AS(q.push_batch(values), std::runtime_error);
+    CHECK(q.empty());
+    CHECK(counted::live == 7);
+  }
+  CHECK(counted::live == 0);
+}
+
+TEST_CASE("inplace_spsc_queue two threads", "[inplace_spsc_queue]")
+{
+  constexpr auto count = std::uint64_t{ 200'000 };
+  auto q = inplace_spsc_queue<std::uint64_t, 64>{};
+
+  auto producer = std::thread([&] {
+    auto next = std::uint64_t{ 0 };
+    auto batch = std::array<std::uint64_t, 5>{};
+    while (next < count) {
+      if (next % 3 == 0) {
+        for (auto i = std::size_t{ 0 }; i < batch.size(); ++i) {
+          batch[i] = next + i;
+        }
+        auto const n = std::min<std::uint64_t>(batch.size(), count - next);
+        next += q.push_batch(std::span(batch).first(n));
+      }
+      else if (q.try_push(next)) {
+        ++next;
+      }
+    }
+  });
+
+  auto received = std::vector<std::uint64_t>{};
+  received.reserve(count);
+  auto batch = std::array<std::uint64_t, 7>{};
+  while (received.size() < count) {
+    if (received.size() % 2 == 0) {
+      auto const n = q.pop_batch(batch);
+      received.insert(received.end(), batch.begin(), batch.begin() + n);
+    }
+    else if (auto value = std::uint64_t{}; q.try_pop(value)) {
+      received.push_back(value);
+    }
+  }
+  producer.join();
+
+  auto in_order = true;
+  for (auto i = std::uint64_t{ 0 }; i < count; ++i) {
+    in_order &= received[i] == i;
+  }
+  CHECK(in_order);
+  CHECK(q.empty());
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include <mtp/inplace_string.hpp>
+
+namespace {
+
+using mtp::inplace_string;
+using namespace std::string_view_literals;
+
+static_assert(std::is_trivially_copyable_v<inplace_string<15>>);
+static_assert(sizeof(inplace_string<15>) == 16);
+static_assert(sizeof(inplace_string<255>) == 256);
+static_assert(sizeof(inplace_string<256>) == 258);
+
+} // namespace
+
+TEST_CASE("inplace_string basics", "[inplace_string]")
+{
+  auto s = inplace_string<8>{};
+  CHECK(s.empty());
+  CHECK(s.c_str()[0] == '\0');
+
+  s = "abc";
+  CHECK(s.size() == 3);
+  CHECK(s == "abc");
+  CHECK(std::strlen(s.c_str()) == 3);
+
+  s += "defgh";
+  CHECK(s.full());
+  CHECK(s == "abcdefgh"sv);
+  CHECK(s.c_str()[8] == '\0');
+  CHECK_THROWS_AS(s.push_back('x'), std::bad_alloc);
+  CHECK(s.try_append("x") == nullptr);
+
+  s.pop_back();
+  CHECK(s == "abcdefg");
+  CHECK(!s.full());
+
+  s.erase(1, 2);
+  CHECK(s == "adefg");
+  CHECK(s.c_str()[5] == '\0');
+
+  s.resize(2);
+  CHECK(s == "ad");
+  s.resize(4, 'z');
+  CHECK(s == "adzz");
+
+  s.clear();
+  CHECK(s.empty());
+  CHECK(s == inplace_string<8>{});
+
+  // the remaining count spans two bytes, 256 left has a zero low byte
+  auto wide = inplace_string<300>(44, 'x');
+  CHECK(wide.size() == 44);
+  CHECK(!wide.full());
+  wide.append(256, 'y');
+  CHECK(wide.full());
+}
+
+TEST_CASE("inplace_string search", "[inplace_string]")
+{
+  auto const s = inplace_string<32>{ "key:value:value" };
+  CHECK(s.find("value") == 4);
+  CHECK(s.rfind("value") == 10);
+  CHECK(s.find('z') == s.npos);
+  CHECK(s.starts_with("key"));
+  CHECK(s.ends_with('e'));
+  CHECK(s.contains(":v"));
+  CHECK(s.substr(4, 5) == "value");
+  CHECK(std::string_view{ s } == "key:value:value");
+}
+
+TEST_CASE("inplace_string comparison and hash", "[inplace_string]")
+{
+  auto const a = inplace_string<16>{ "apple" };
+  auto b = inplace_string<16>{ "apples" };
+  CHECK(a != b);
+  CHECK(a < b);
+  b.pop_back();
+  CHECK(a == b);
+  CHECK(std::memcmp(&a, &b, sizeof(a)) == 0);
+
+  auto const h = std::hash<inplace_string<16>>{};
+  CHECK(h(a) == std::hash<std::string_view>{}("apple"));
+}
+
+TEST_CASE("inplace_string constexpr support", "[inplace_string]")
+{
+  constexpr auto s = []() {
+    auto str = inplace_string<4>{ "ab" };
+    str += 'c';
+    str.push_back('d');
+    return str;
+  }();
+  static_assert(s.full() && s.size() == 4 && s == "abcd");
+  static_assert(s.c_str()[4] == '\0');
+}
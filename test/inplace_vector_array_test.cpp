@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <mtp/inplace_vector_array.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+using mtp::inplace_vector_array;
+
+// a byte per row in the size column
+static_assert(std::is_same_v<inplace_vector_array<int, 16>::row_size_type, std::uint8_t>);
+
+} // namespace
+
+TEST_CASE("inplace_vector_array rows", "[inplace_vector_array]")
+{
+  auto rows = inplace_vector_array<int, 4>(2);
+  CHECK(rows.size() == 2);
+  CHECK(rows[0].empty());
+
+  auto const first = rows[0];
+  first.push_back(1);
+  first.emplace_back(2);
+  CHECK(first.try_push_back(3));
+  CHECK(first.size() == 3);
+  CHECK(rows.sizes()[0] == 3);
+
+  // bulk append takes what fits
+  auto const values = std::array{ 4, 5, 6 };
+  CHECK(first.try_append_range(values) == values.begin() + 1);
+  CHECK(!first.try_push_back(7));
+  CHECK_THROWS_AS(first.push_back(7), std::bad_alloc);
+  CHECK_THROWS_AS(rows[1].append_range(std::vector{ 1, 2, 3, 4, 5 }), std::bad_alloc);
+  CHECK(first.to_inplace_vector() == inplace_vector<int, 4>{ 1, 2, 3, 4 });
+
+  first.pop_back();
+  CHECK(first.back() == 3);
+  rows[1].append_range(values);
+  CHECK(rows[1][2] == 6);
+
+  auto const& view = rows;
+  CHECK(view[1].size() == 3);
+  CHECK(view[1][0] == 4);
+
+  rows.push_back(values);
+  CHECK_THROWS_AS(rows.push_back(std::vector{ 1, 2, 3, 4, 5 }), std::bad_alloc);
+  CHECK(rows.size() == 3);
+  CHECK(rows.total_size() == 9);
+  CHECK(rows.count_if_size([](std::size_t size) { return size == 3; }) == 3);
+
+  rows[2].clear();
+  rows.pop_back();
+  CHECK(rows.size() == 2);
+}
+
+TEST_CASE("inplace_vector_array growth relocates rows", "[inplace_vector_array]")
+{
+  auto strings = inplace_vector_array<std::string, 3>{};
+  for (auto r = 0; r < 100; ++r) {
+    auto const row = strings.emplace_back();
+    for (auto i = 0; i < r % 4 && i < 3; ++i) {
+      row.emplace_back(std::string(32, static_cast<char>('a' + i)));
+    }
+  }
+  CHECK(strings.capacity() >= 100);
+  CHECK(strings.total_size() == 25 * (0 + 1 + 2 + 3));
+  CHECK(strings[99][2] == std::string(32, 'c'));
+
+  auto copy = strings;
+  CHECK(copy[98][1] == std::string(32, 'b'));
+  auto moved = std::move(copy);
+  CHECK(moved.size() == 100);
+  CHECK(copy.empty());
+
+  moved.resize(10);
+  CHECK(moved.total_size() == 13);
+  moved = strings;
+  CHECK(moved.size() == 100);
+
+  auto owners = inplace_vector_array<std::unique_ptr<int>, 2>{};
+  for (auto r = 0; r < 20; ++r) {
+    owners.emplace_back().emplace_back(std::make_unique<int>(r));
+  }
+  CHECK(*owners[19][0] == 19);
+  owners.clear();
+  CHECK(owners.total_size() == 0);
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mtp/inplace_vector.hpp>
+#include <mtp/inplace_vector_interop.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+
+template <typename T>
+auto
+make(int i) -> T
+{
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(32, static_cast<char>('a' + i)); // past the small string buffer
+  }
+  else {
+    return T{ i };
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("std::vector interop", "[inplace_vector_interop]", int, std::string)
+{
+  using T = TestType;
+  using IpvT = inplace_vector<T, 4>;
+  using mtp::overflow;
+
+  auto const one = make<T>(1);
+  auto const two = make<T>(2);
+  auto const three = make<T>(3);
+
+  auto vec = std::vector<T>{ one, two, three };
+  auto const capacity = vec.capacity();
+  auto ipv = mtp::from_vector<4>(std::move(vec));
+  CHECK(ipv == IpvT{ one, two, three });
+  CHECK(vec.empty());
+  CHECK(vec.capacity() == capacity);
+
+  auto back = mtp::into_vector(std::move(ipv));
+  CHECK(back == std::vector<T>{ one, two, three });
+  CHECK(ipv.empty());
+
+  // overflow
+  back.push_back(make<T>(4));
+  back.push_back(make<T>(5));
+  CHECK_THROWS_AS(mtp::from_vector<4>(std::move(back)), std::bad_alloc);
+  CHECK(back.size() == 5);
+  CHECK(mtp::from_vector<4, overflow::truncate>(std::move(back)) ==
+        IpvT{ one, two, three, make<T>(4) });
+  CHECK(back.empty());
+  CHECK(mtp::from_vector<4>(std::move(back)).empty());
+
+  // with an allocator
+  ipv = IpvT{ one };
+  auto const alloc = std::allocator<T>{};
+  CHECK(mtp::into_vector(std::move(ipv), alloc) == std::vector<T>{ one });
+  CHECK(mtp::into_vector(std::move(ipv)).empty());
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <type_traits>
+
+#include <mtp/inplace_vector_ref.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+using mtp::inplace_vector_ref;
+
+// one non-template function serves every capacity
+auto
+append_squares(inplace_vector_ref<int> out, int count) -> bool
+{
+  for (auto i = 1; i <= count; ++i) {
+    if (!out.try_push_back(i * i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr auto
+insert_and_erase() -> int
+{
+  auto ipv = inplace_vector<int, 4>{ 1, 3 };
+  auto const ref = inplace_vector_ref<int>(ipv);
+  ref.insert(ref.begin() + 1, 2);
+  ref.erase(ref.begin());
+  return static_cast<int>(ipv.size()) * 10 + ipv[0];
+}
+
+static_assert(insert_and_erase() == 22);
+static_assert(std::is_trivially_copyable_v<inplace_vector_ref<int>>);
+static_assert(std::is_convertible_v<inplace_vector<int, 3>&, inplace_vector_ref<int>>);
+static_assert(!std::is_convertible_v<inplace_vector<int, 3> const&, inplace_vector_ref<int>>);
+
+} // namespace
+
+TEST_CASE("inplace_vector_ref writes through to any capacity", "[inplace_vector_ref]")
+{
+  // uint8_t, uint16_t and uint32_t size objects
+  auto small = inplace_vector<int, 4>{};
+  auto medium = inplace_vector<int, 300>{};
+  auto large = inplace_vector<int, 70000>{};
+
+  CHECK(!append_squares(small, 5));
+  CHECK(small == inplace_vector<int, 4>{ 1, 4, 9, 16 });
+  CHECK(append_squares(medium, 260));
+  CHECK(medium.size() == 260);
+  CHECK(medium.back() == 260 * 260);
+  CHECK(append_squares(large, 66000));
+  CHECK(large.size() == 66000);
+
+  auto const ref = inplace_vector_ref<int>(small);
+  CHECK(ref.capacity() == 4);
+  CHECK(ref.data() == small.data());
+  CHECK(std::span<int>(ref).size() == 4);
+  CHECK_THROWS_AS(ref.push_back(25), std::bad_alloc);
+
+  ref.pop_back();
+  CHECK(small.size() == 3);
+  ref.clear();
+  CHECK(small.empty());
+
+  auto empty = inplace_vector<int, 0>{};
+  auto const none = inplace_vector_ref<int>(empty);
+  CHECK(none.capacity() == 0);
+  CHECK(none.empty());
+  CHECK(!none.try_push_back(1));
+  none.clear();
+}
+
+TEST_CASE("inplace_vector_ref insert and erase", "[inplace_vector_ref]")
+{
+  SECTION("trivially relocatable")
+  {
+    auto ipv = inplace_vector<int, 8>{ 1, 2, 5 };
+    auto const ref = inplace_vector_ref<int>(ipv);
+
+    CHECK(*ref.insert(ref.begin() + 2, 4) == 4);
+    CHECK(*ref.emplace(ref.begin() + 2, 3) == 3);
+    CHECK(ipv == inplace_vector<int, 8>{ 1, 2, 3, 4, 5 });
+    ref.insert(ref.begin(), 2, 0);
+    CHECK(ipv == inplace_vector<int, 8>{ 0, 0, 1, 2, 3, 4, 5 });
+    CHECK_THROWS_AS(ref.insert(ref.end(), 2, 9), std::bad_alloc);
+    CHECK(ipv.size() == 7);
+
+    CHECK(*ref.erase(ref.begin()) == 0);
+    CHECK(*ref.erase(ref.begin(), ref.begin() + 2) == 2);
+    CHECK(ipv == inplace_vector<int, 8>{ 2, 3, 4, 5 });
+    CHECK(ref.erase(ref.end(), ref.end()) == ref.end());
+  }
+
+  SECTION("non-trivial elements")
+  {
+    auto ipv = inplace_vector<std::string, 4>{ "a", "c" };
+    auto const ref = inplace_vector_ref<std::string>(ipv);
+
+    ref.insert(ref.begin() + 1, std::string("b"));
+    ref.emplace_back(3, 'd');
+    CHECK(ipv == inplace_vector<std::string, 4>{ "a", "b", "c", "ddd" });
+    ref.erase(ref.begin(), ref.begin() + 2);
+    CHECK(ipv == inplace_vector<std::string, 4>{ "c", "ddd" });
+
+    auto pointers = inplace_vector<std::unique_ptr<int>, 2>{};
+    auto const owner = inplace_vector_ref<std::unique_ptr<int>>(pointers);
+    owner.push_back(std::make_unique<int>(2));
+    owner.insert(owner.begin(), std::make_unique<int>(1));
+    CHECK(*pointers[0] == 1);
+    CHECK(*pointers[1] == 2);
+  }
+}
@@ -6,10 +6,17 @@
 import std;
 #else
 #  include <algorithm>
+#  include <forward_list>
+#  include <functional>
+#  include <new>
+#  include <optional>
 #  if defined(__cpp_lib_containers_ranges) || defined(__cpp_lib_ranges_to_container)
 #    include <ranges>
 #  endif
+#  include <string>
 #  include <type_traits>
+#  include <unordered_set>
+#  include <vector>
 #endif
 
 #ifdef MTP_BUILD_MODULE
@@ -91,6 +98,23 @@ static_assert(std::is_trivially_move_constructible_v<move_only>);
 static_assert(std::is_trivially_move_assignable_v<move_only>);
 static_assert(std::is_trivially_destructible_v<move_only>);
 
+struct literal_non_trivial
+{
+  int value{ 0 };
+
+  constexpr literal_non_trivial(int v) : value{ v } {}
+  constexpr
+  operator int() const noexcept
+  {
+    return value;
+  }
+
+  literal_non_trivial() = default;
+  constexpr ~literal_non_trivial() {} // non-trivial, but usable in constant expressions
+};
+static_assert(!std::is_trivially_default_constructible_v<literal_non_trivial>);
+static_assert(!std::is_trivially_destructible_v<literal_non_trivial>);
+
 template <typename T, std::size_t N>
 consteval auto
 test_triviality() -> void
@@ -358,10 +382,95 @@ test_modifications() -> void
   vec.swap(vec_copy);
   CHECK(ipv.size() == vec.size());
   CHECK(std::equal(vec.begin(), vec.end(), ipv.begin()));
+
+  // assign, shrinking
+  ipv.assign(arr_34.begin(), arr_34.end());
+  vec.assign(arr_34.begin(), arr_34.end());
+  CHECK(ipv.size() == vec.size());
+  CHECK(std::equal(vec.begin(), vec.end(), ipv.begin()));
+
+  auto const list_3 = std::forward_list<T>{ T{3} };
+  ipv.assign(list_3.begin(), list_3.end());
+  vec.assign(list_3.begin(), list_3.end());
+  CHECK(ipv.size() == vec.size());
+  CHECK(std::equal(vec.begin(), vec.end(), ipv.begin()));
+}
+
+template <typename T>
+auto
+test_cross_capacity() -> void
+{
+  using small = inplace_vector<T, 4>;
+  using large = inplace_vector<T, 8>;
+
+  static_assert(std::is_convertible_v<small const&, large>);
+  static_assert(!std::is_convertible_v<large const&, small>);
+  static_assert(std::is_constructible_v<small, large const&>);
+
+  // conversions
+  auto const s = small{ T{1}, T{2}, T{3} };
+  auto l = large(s);
+  CHECK(l == large{ T{1}, T{2}, T{3} });
+  CHECK(small(l) == s);
+  l.push_back(T{4});
+  l.push_back(T{5});
+  CHECK_THROWS_AS(small(l), std::bad_alloc);
+
+  l.pop_back();
+  auto moved = small{ T{9} };
+  moved = std::move(l);
+  CHECK(moved.size() == 4);
+  CHECK(moved.front() == T{1});
+  CHECK(l.empty());
+  CHECK_THROWS_AS(moved = large(5, T{0}), std::bad_alloc);
+  CHECK(moved.size() == 4);
+  l = moved;
+  CHECK(l == large{ T{1}, T{2}, T{3}, T{4} });
+  auto relocated = large(std::move(moved));
+  CHECK(relocated == l);
+  CHECK(moved.empty());
+
+  // splice
+  auto dst = large{ T{1}, T{5} };
+  auto src = small{ T{2}, T{3}, T{4}, T{6} };
+  auto const it = dst.splice(dst.begin() + 1, src, src.begin(), src.begin() + 3);
+  CHECK(it == dst.begin() + 1);
+  CHECK(dst == large{ T{1}, T{2}, T{3}, T{4}, T{5} });
+  CHECK(src == small{ T{6} });
+  dst.splice(dst.end(), src);
+  CHECK(dst == large{ T{1}, T{2}, T{3}, T{4}, T{5}, T{6} });
+  CHECK(src.empty());
+  auto too_many = small{ T{7}, T{8}, T{9} };
+  CHECK_THROWS_AS(dst.splice(dst.end(), too_many), std::bad_alloc);
+  CHECK(dst.size() == 6);
+  CHECK(too_many.size() == 3);
+
+  // split_at and extract_back
+  auto back = dst.split_at(4);
+  static_assert(std::is_same_v<decltype(back), large>);
+  CHECK(dst == large{ T{1}, T{2}, T{3}, T{4} });
+  CHECK(back == large{ T{5}, T{6} });
+  auto const last_two = dst.template extract_back<2>(2);
+  CHECK(last_two == inplace_vector<T, 2>{ T{3}, T{4} });
+  CHECK(dst == large{ T{1}, T{2} });
+  CHECK_THROWS_AS(dst.template extract_back<1>(2), std::bad_alloc);
+  CHECK(dst.extract_back(0).empty());
+  CHECK(dst.split_at(0) == large{ T{1}, T{2} });
+  CHECK(dst.empty());
 }
 
 } // namespace
 
+template <>
+struct mtp::inplace_vector_hash<trivial>
+{
+  auto
+  operator()(trivial const*, std::size_t size) const noexcept -> std::size_t
+  {
+    return size;
+  }
+};
+
 TEMPLATE_TEST_CASE("triviality", "[inplace_vector]", trivial, non_trivial, move_only)
 {
   using T = TestType;
@@ -389,18 +498,132 @@ TEMPLATE_TEST_CASE("modifications", "[inplace_vector]", trivial, non_trivial)
   test_modifications<T>();
 }
 
-TEMPLATE_TEST_CASE("constexpr support", "[inplace_vector]", trivial)
+TEMPLATE_TEST_CASE("cross capacity", "[inplace_vector]", trivial, non_trivial)
 {
   using T = TestType;
-  using IpvT = inplace_vector<T, 4>;
+  test_cross_capacity<T>();
+}
 
-  static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>);
+TEMPLATE_TEST_CASE("constexpr support", "[inplace_vector]", trivial, literal_non_trivial)
+{
+  using T = TestType;
+  using IpvT = inplace_vector<T, 4>;
 
+  // full, so that it persists for any literal T (see byte_storage)
   constexpr auto ipv = []() {
-    auto v = IpvT{};
+    auto v = inplace_vector<T, 2>{};
     v.push_back(T{1});
     v.push_back(T{2});
     return v;
   }();
   static_assert(ipv.size() == 2 && ipv.front() == T{1} && ipv.back() == T{2});
+
+  constexpr auto halves = []() {
+    auto v = inplace_vector<T, 8>{ T{1}, T{2}, T{3} };
+    auto w = IpvT{ T{0} };
+    w.splice(w.end(), v, v.begin(), v.begin() + 1);
+    auto const back = v.split_at(1);
+    return std::array{ w.size(), v.size(), back.size() };
+  }();
+  static_assert(halves == std::array<std::size_t, 3>{ 2, 1, 1 });
+
+  // built by the compiler, not at startup; spare slots persist for trivially destructible T
+  if constexpr (std::is_trivially_destructible_v<T>) {
+    constexpr auto table = std::array{ IpvT{ T{1} }, IpvT{}, IpvT{ T{2}, T{3} } };
+    static_assert(table[0].size() == 1 && table[1].empty() && table[2].back() == T{3});
+    CHECK(table[2].front() == T{2});
+  }
+  else {
+    constexpr auto table = std::array{ inplace_vector<T, 1>{ T{1} }, inplace_vector<T, 1>{ T{2} } };
+    static_assert(table[0].front() == T{1} && table[1].back() == T{2});
+    CHECK(table[1].front() == T{2});
+  }
+}
+
+TEST_CASE("constexpr support without default construction", "[inplace_vector]")
+{
+  // slots are only constructed when used, so T needs no default constructor
+  struct literal_no_default
+  {
+    int value;
+
+    constexpr explicit literal_no_default(int v) : value{ v } {}
+    constexpr ~literal_no_default() {}
+  };
+  static_assert(!std::is_default_constructible_v<literal_no_default>);
+
+  constexpr auto values = []() {
+    auto v = inplace_vector<literal_no_default, 4>{};
+    v.emplace_back(1);
+    v.emplace_back(2);
+    v.emplace(v.begin(), 0);
+    v.pop_back();
+    return std::array{ v.size(), std::size_t(v[0].value), std::size_t(v[1].value) };
+  }();
+  static_assert(values == std::array<std::size_t, 3>{ 2, 0, 1 });
+
+  constexpr auto full = inplace_vector<literal_no_default, 2>{ literal_no_default(3),
+                                                               literal_no_default(4) };
+  static_assert(full.size() == 2 && full.back().value == 4);
+  CHECK(full.front().value == 3);
+}
+
+TEST_CASE("constexpr tables of standard types", "[inplace_vector]")
+{
+  using entry = inplace_vector<std::optional<int>, 4>;
+
+  static constexpr auto table = std::array{ entry{ 1, std::nullopt }, entry{}, entry{ 3 } };
+  static_assert(table[0].size() == 2 && !table[0][1] && *table[2][0] == 3);
+  CHECK(table[0][0] == 1);
+
+  // slots are constructed when used, each allocation is freed by the element that owns it
+  constexpr auto lengths = []() {
+    auto v = inplace_vector<std::string, 4>{ std::string(40, 'x') };
+    v.insert(v.begin(), "y");
+    v.emplace_back(std::vector<char>(20, 'z').size(), 'z');
+    v.erase(v.begin() + 1);
+    return std::array{ v.size(), v[0].size(), v[1].size() };
+  }();
+  static_assert(lengths == std::array<std::size_t, 3>{ 2, 1, 20 });
+}
+
+TEST_CASE("hash", "[inplace_vector]")
+{
+  using ints = inplace_vector<int, 8>;
+  auto const hash = std::hash<ints>{};
+  CHECK(hash(ints{ 1, 2, 3 }) == hash(ints{ 1, 2, 3 }));
+  CHECK(hash(ints{ 1, 2, 3 }) == std::hash<inplace_vector<int, 64>>{}({ 1, 2, 3 }));
+  CHECK(hash(ints{ 1, 2, 3 }) != hash(ints{ 1, 2 }));
+  CHECK(hash(ints{ 1, 2, 3 }) != hash(ints{ 3, 2, 1 }));
+  CHECK(hash(ints{}) != hash(ints{ 0 }));
+
+  // single bit patterns over every length up to a few words, none expected to collide
+  auto seen = std::unordered_set<std::size_t>{};
+  for (auto size = 0u; size <= 8; ++size) {
+    for (auto bit = 0u; bit < 32; ++bit) {
+      auto ipv = ints(size, 0);
+      if (size > 0) {
+        ipv[bit % size] = 1 << bit;
+      }
+      seen.insert(hash(ipv));
+    }
+  }
+  CHECK(seen.size() == 1 + 8 * 32);
+
+  // non unique representations go element by element, equal values hash equal
+  using doubles = inplace_vector<double, 4>;
+  CHECK(std::hash<doubles>{}({ 0.0, 1.0 }) == std::hash<doubles>{}({ -0.0, 1.0 }));
+  using strings = inplace_vector<std::string, 4>;
+  CHECK(std::hash<strings>{}({ "a", "bc" }) != std::hash<strings>{}({ "ab", "c" }));
+
+  auto set = std::unordered_set<ints>{ { 1 }, { 1, 2 }, { 1 } };
+  CHECK(set.size() == 2);
+
+  // user supplied element hash
+  using trivials = inplace_vector<trivial, 4>;
+  CHECK(std::hash<trivials>{}({ 1, 2 }) == 2);
+
+  // disabled like `std::hash<T>` when the elements cannot be hashed
+  static_assert(!std::is_default_constructible_v<std::hash<inplace_vector<std::vector<int>, 4>>>);
+  static_assert(std::is_default_constructible_v<std::hash<strings>>);
 }
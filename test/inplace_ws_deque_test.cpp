@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <mtp/inplace_ws_deque.hpp>
+
+namespace {
+
+using mtp::inplace_ws_deque;
+
+// top, bottom and the slots each start a cache line
+static_assert(sizeof(inplace_ws_deque<std::uint32_t, 4>) >= 3 * 64);
+
+} // namespace
+
+TEST_CASE("inplace_ws_deque single thread", "[inplace_ws_deque]")
+{
+  auto d = inplace_ws_deque<int, 4>{};
+  auto value = 0;
+  CHECK(d.empty());
+  CHECK(!d.try_pop(value));
+  CHECK(!d.try_steal(value));
+
+  for (auto i = 1; i <= 4; ++i) {
+    CHECK(d.try_push(i));
+  }
+  CHECK(!d.try_push(5));
+  CHECK(d.size() == 4);
+
+  // the owner works LIFO, thieves FIFO
+  CHECK(d.try_pop(value));
+  CHECK(value == 4);
+  CHECK(d.try_steal(value));
+  CHECK(value == 1);
+
+  // wraps around the ring
+  CHECK(d.try_push(5));
+  CHECK(d.try_push(6));
+  CHECK(!d.try_push(7));
+
+  auto stolen = std::array<int, 4>{};
+  CHECK(d.steal_half(stolen) == 2);
+  CHECK(stolen[0] == 2);
+  CHECK(stolen[1] == 3);
+  CHECK(d.steal_half(std::span(stolen).first(0)) == 0);
+  CHECK(d.steal_half(stolen) == 1);
+  CHECK(stolen[0] == 5);
+
+  CHECK(d.try_pop(value));
+  CHECK(value == 6);
+  CHECK(!d.try_pop(value));
+  CHECK(d.empty());
+}
+
+TEST_CASE("inplace_ws_deque owner and thieves", "[inplace_ws_deque]")
+{
+  constexpr auto count = std::uint32_t{ 100'000 };
+  constexpr auto thieves = 3;
+  auto d = inplace_ws_deque<std::uint32_t, 64>{};
+  auto done = std::atomic<bool>{ false };
+
+  auto taken = std::array<std::vector<std::uint32_t>, thieves + 1>{};
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < thieves; ++t) {
+    threads.emplace_back([&, t] {
+      auto& mine = taken[t + 1];
+      auto batch = std::array<std::uint32_t, 8>{};
+      while (!done.load(std::memory_order_acquire) || !d.empty()) {
+        if (t == 0) {
+          auto const n = d.steal_half(batch);
+          mine.insert(mine.end(), batch.begin(), batch.begin() + n);
+        }
+        else if (auto value = std::uint32_t{}; d.try_steal(value)) {
+          mine.push_back(value);
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // the owner pushes everything, popping some back itself and whenever the ring is full
+  auto& mine = taken[0];
+  for (auto next = std::uint32_t{ 0 }; next < count;) {
+    if (d.try_push(next)) {
+      ++next;
+    }
+    if (next % 5 == 0 || d.size() == d.capacity()) {
+      if (auto value = std::uint32_t{}; d.try_pop(value)) {
+        mine.push_back(value);
+      }
+    }
+  }
+  for (auto value = std::uint32_t{}; d.try_pop(value);) {
+    mine.push_back(value);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto seen = std::vector<int>(count, 0);
+  for (auto const& values : taken) {
+    for (auto const value : values) {
+      ++seen[value];
+    }
+  }
+  auto exactly_once = true;
+  for (auto const n : seen) {
+    exactly_once &= n == 1;
+  }
+  CHECK(exactly_once);
+  CHECK(d.empty());
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <mtp/seqlock_inplace_vector.hpp>
+
+namespace {
+
+using mtp::inplace_vector;
+using mtp::seqlock_inplace_vector;
+
+struct route
+{
+  std::uint32_t prefix;
+  std::uint16_t port;
+};
+
+} // namespace
+
+TEST_CASE("seqlock_inplace_vector publish and load", "[seqlock_inplace_vector]")
+{
+  auto table = seqlock_inplace_vector<route, 4>{};
+  CHECK(table.version() == 0);
+  CHECK(table.load().empty());
+
+  table.publish({ route{ 10, 1 }, route{ 20, 2 }, route{ 30, 3 } });
+  CHECK(table.version() == 1);
+  auto snapshot = table.load();
+  REQUIRE(snapshot.size() == 3);
+  CHECK(snapshot[2].prefix == 30);
+  CHECK(snapshot[2].port == 3);
+
+  // a shorter table leaves no trace of the longer one
+  table.publish({ route{ 40, 4 } });
+  CHECK(table.version() == 2);
+  CHECK(table.try_load(snapshot));
+  REQUIRE(snapshot.size() == 1);
+  CHECK(snapshot[0].prefix == 40);
+
+  auto const bytes = seqlock_inplace_vector<std::uint8_t, 3>(inplace_vector<std::uint8_t, 3>{ 1, 2, 3 });
+  CHECK(bytes.load() == inplace_vector<std::uint8_t, 3>{ 1, 2, 3 });
+}
+
+TEST_CASE("seqlock_inplace_vector readers never see a torn table", "[seqlock_inplace_vector]")
+{
+  constexpr auto versions = std::uint64_t{ 20'000 };
+  auto table = seqlock_inplace_vector<std::uint64_t, 64>{};
+  auto stop = std::atomic<bool>{ false };
+
+  // every published table is `version % 64 + 1` copies of its version
+  auto consistent = std::atomic<bool>{ true };
+  auto readers = std::vector<std::thread>{};
+  for (auto r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      auto last = std::uint64_t{ 0 };
+      auto monotonic = true;
+      auto whole = true;
+      while (!stop.load(std::memory_order_acquire)) {
+        auto const snapshot = table.load();
+        if (snapshot.empty()) {
+          continue;
+        }
+        auto const version = snapshot[0];
+        whole &= snapshot.size() == version % 64 + 1;
+        for (auto const value : snapshot) {
+          whole &= value == version;
+        }
+        monotonic &= version >= last;
+        last = version;
+      }
+      if (!whole || !monotonic) {
+        consistent.store(false);
+      }
+    });
+  }
+
+  for (auto version = std::uint64_t{ 1 }; version <= versions; ++version) {
+    table.publish(inplace_vector<std::uint64_t, 64>(version % 64 + 1, version));
+  }
+  stop.store(true, std::memory_order_release);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  CHECK(consistent.load());
+  CHECK(table.version() == versions);
+}